@@ -21,6 +21,10 @@ public:
         return m_MasterHandle;
     }
 
+    Component() = default;
+    Component(const Component&) = default;
+    Component(Component&&) = default;
+
     virtual ~Component(){}
     
 protected:
@@ -72,4 +76,8 @@ private:
 
 };
 
+// false for components defined through DefinePodComponent, which carry no vtable nor master handle
+template<typename T>
+inline constexpr bool IsVirtualComponent = std::is_base_of<Component, T>::value;
+
 };
@@ -0,0 +1,138 @@
+#pragma once
+#include "../global.h"
+#include <array>
+#include <bit>
+#include <limits>
+#include <algorithm>
+#include <memory_resource>
+#include <vector>
+
+
+namespace ecspp {
+
+using ComponentIndex = uint16_t;
+
+inline constexpr ComponentIndex NullComponentIndex = std::numeric_limits<ComponentIndex>::max();
+
+/**
+ * Fixed size bitset indexed by the dense component index handed out by the ObjectPropertyRegister.
+ */
+class ComponentMask {
+public:
+	void Set(ComponentIndex index) {
+		m_Words[index / 64] |= (uint64_t(1) << (index % 64));
+	}
+
+	void Reset(ComponentIndex index) {
+		m_Words[index / 64] &= ~(uint64_t(1) << (index % 64));
+	}
+
+	bool Test(ComponentIndex index) const {
+		if (index >= ECSPP_MAX_COMPONENT_TYPES) {
+			return false;
+		}
+		return (m_Words[index / 64] >> (index % 64)) & 1;
+	}
+
+	bool None() const {
+		for (auto word : m_Words) {
+			if (word != 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	size_t Count() const {
+		size_t count = 0;
+		for (auto word : m_Words) {
+			count += std::popcount(word);
+		}
+		return count;
+	}
+
+	template<typename Func>
+	void ForEach(Func&& func) const {
+		for (size_t wordIndex = 0; wordIndex < m_Words.size(); wordIndex++) {
+			uint64_t word = m_Words[wordIndex];
+			while (word != 0) {
+				func(static_cast<ComponentIndex>(wordIndex * 64 + std::countr_zero(word)));
+				word &= word - 1;
+			}
+		}
+	}
+
+private:
+	std::array<uint64_t, (ECSPP_MAX_COMPONENT_TYPES + 63) / 64> m_Words{};
+
+};
+
+/**
+ * Small list of component indices that keeps the first few entries inline and only allocates past that.
+ */
+class ComponentIndexList {
+public:
+	static constexpr size_t InlineCapacity = 8;
+
+	ComponentIndexList(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : m_Overflow(resource) {};
+
+	const ComponentIndex* begin() const {
+		return data();
+	}
+
+	const ComponentIndex* end() const {
+		return data() + m_Size;
+	}
+
+	const ComponentIndex* data() const {
+		return m_Overflow.empty() ? m_Inline.data() : m_Overflow.data();
+	}
+
+	size_t size() const {
+		return m_Size;
+	}
+
+	bool empty() const {
+		return m_Size == 0;
+	}
+
+	ComponentIndex operator[](size_t index) const {
+		return data()[index];
+	}
+
+	void push_back(ComponentIndex index) {
+		if (m_Overflow.empty() && m_Size < InlineCapacity) {
+			m_Inline[m_Size++] = index;
+			return;
+		}
+		if (m_Overflow.empty()) {
+			m_Overflow.assign(m_Inline.begin(), m_Inline.begin() + m_Size);
+		}
+		m_Overflow.push_back(index);
+		m_Size++;
+	}
+
+	void erase(ComponentIndex index) {
+		ComponentIndex* first = m_Overflow.empty() ? m_Inline.data() : m_Overflow.data();
+		ComponentIndex* last = first + m_Size;
+
+		auto it = std::find(first, last, index);
+		if (it == last) {
+			return;
+		}
+		std::copy(it + 1, last, it);
+		m_Size--;
+
+		if (!m_Overflow.empty()) {
+			m_Overflow.pop_back();
+		}
+	}
+
+private:
+	std::array<ComponentIndex, InlineCapacity> m_Inline{};
+	std::pmr::vector<ComponentIndex> m_Overflow;
+	uint16_t m_Size = 0;
+
+};
+
+};
@@ -19,8 +19,20 @@ public:
 		return Registry().storage<ComponentName>().size();
 	}
 
+	static void UpdateAll(float deltaTime) {
+		ObjectPropertyRegister::UpdateAllComponents<ComponentName>(deltaTime);
+	}
+
+	static void SetUpdateRate(float updatesPerSecond) {
+		ObjectPropertyRegister::SetComponentUpdateRate<ComponentName>(updatesPerSecond);
+	}
+
+	static void SetUpdateStagger(uint32_t bucketCount) {
+		ObjectPropertyRegister::SetComponentUpdateStagger<ComponentName>(bucketCount);
+	}
+
 	static void ForEach(std::function<void(ComponentName&)> func) {
-		auto view = Registry().view<ComponentName>();
+		auto view = Registry().view<ComponentName>(entt::exclude<ParkedObject, PendingDeletion>);
 		for (auto entity : view) {
 			func(view.template get<ComponentName>(entity));
 		}
@@ -30,7 +42,21 @@ public:
 		return { this->GetMasterHandle()};
 	};
 
+	// storages swap instances together with their entities when groups or sorting reorder them, so the masters follow
+	friend void swap(ComponentName& first, ComponentName& second) {
+		ComponentName temp(std::move(first));
+		first = std::move(second);
+		second = std::move(temp);
+		SwapMasters(first, second);
+	}
+
 private:
+	static void SwapMasters(Component& first, Component& second) {
+		entt::entity master = first.GetMasterHandle();
+		first.SetMaster(second.GetMasterHandle());
+		second.SetMaster(master);
+	}
+
 	static inline bool dummyVar = []() {
 		ObjectPropertyRegister::RegisterClassAsComponentOfType<ComponentName, ComponentType>();
 		return true;
@@ -39,6 +65,81 @@ private:
 
 };
 
+/**
+ * Base for plain data components, without Init/Destroy/Update or a master handle.
+ */
+template<typename ComponentName>
+class DefinePodComponent {
+public:
+	DefinePodComponent() {
+		(void)dummyVar;
+	};
+
+	static std::string GetTypeName() {
+		return HelperFunctions::GetClassName<ComponentName>();
+	}
+
+	static size_t AliveCount() {
+		return Registry().storage<ComponentName>().size();
+	}
+
+	static void ForEach(std::function<void(entt::entity, ComponentName&)> func) {
+		for (auto [entity, comp] : Registry().view<ComponentName>(entt::exclude<ParkedObject, PendingDeletion>).each()) {
+			func(entity, comp);
+		}
+	}
+
+private:
+	static inline bool dummyVar = []() {
+		static_assert(std::is_trivially_copyable<ComponentName>::value, "Pod components must be trivially copyable!");
+		ObjectPropertyRegister::RegisterClassAsPodComponent<ComponentName>();
+		return true;
+	}();
+
+};
+
+/**
+ * Base for numeric components stored as one column per field listed in ComponentName::Fields.
+ */
+template<typename ComponentName>
+class DefineSoAComponent : public SoAComponent {
+public:
+	DefineSoAComponent() {
+		(void)dummyVar;
+	};
+
+	static std::string GetTypeName() {
+		return HelperFunctions::GetClassName<ComponentName>();
+	}
+
+	static size_t AliveCount() {
+		return ObjectPropertyRegister::GetSoAStorage<ComponentName>().Size();
+	}
+
+	template<auto Field>
+	static auto Column() {
+		return ObjectPropertyRegister::GetSoAStorage<ComponentName>().template Column<Field>();
+	}
+
+	static std::span<const entt::entity> Entities() {
+		return ObjectPropertyRegister::GetSoAStorage<ComponentName>().Entities();
+	}
+
+private:
+	static inline bool dummyVar = []() {
+		ObjectPropertyRegister::RegisterClassAsSoAComponent<ComponentName>();
+		return true;
+	}();
+
+};
+
+/**
+ * Keeps instances at a fixed address, erasing leaves a tombstone. Such types can't be owned by groups.
+ */
+struct PointerStable {
+	static constexpr bool in_place_delete = true;
+};
+
 template<typename ObjectType,typename ComponentType>
 class RegisterComponent {
 public:
@@ -0,0 +1,18 @@
+#pragma once
+#include "../global.h"
+
+
+namespace ecspp {
+
+using Tick = uint32_t;
+
+/**
+ * Stored next to every component of type T, holds the ticks at which it was added and last written.
+ */
+template<typename T>
+struct ComponentTicks {
+	Tick m_Added = 0;
+	Tick m_Changed = 0;
+};
+
+};
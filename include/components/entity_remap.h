@@ -0,0 +1,36 @@
+#pragma once
+#include "../global.h"
+#include <algorithm>
+
+
+namespace ecspp {
+
+/**
+ * Maps the objects of a cloned subtree to their clones, components can define RemapEntities(const EntityRemap&).
+ */
+class EntityRemap {
+public:
+	EntityRemap(const std::vector<entt::entity>& sources, const std::vector<entt::entity>& clones) {
+		m_Pairs.reserve(sources.size());
+		for (size_t i = 0; i < sources.size(); i++) {
+			m_Pairs.emplace_back(sources[i], clones[i]);
+		}
+		std::sort(m_Pairs.begin(), m_Pairs.end());
+	};
+
+	entt::entity operator()(entt::entity e) const {
+		auto it = std::lower_bound(m_Pairs.begin(), m_Pairs.end(), e, [](const std::pair<entt::entity, entt::entity>& pair, entt::entity value) {
+			return pair.first < value;
+		});
+		if (it != m_Pairs.end() && it->first == e) {
+			return it->second;
+		}
+		return e;
+	}
+
+private:
+	std::vector<std::pair<entt::entity, entt::entity>> m_Pairs;
+
+};
+
+};
@@ -0,0 +1,201 @@
+#pragma once
+#include "../global.h"
+#include "../object/registry.h"
+#include <tuple>
+#include <span>
+#include <vector>
+
+
+namespace ecspp {
+
+// marker base of the components defined through DefineSoAComponent
+struct SoAComponent {};
+
+template<typename T>
+inline constexpr bool IsSoAComponent = std::is_base_of<SoAComponent, T>::value;
+
+namespace SoAHelpers {
+
+	template<typename>
+	struct MemberType;
+
+	template<typename Class, typename Member>
+	struct MemberType<Member Class::*> {
+		using type = Member;
+	};
+
+	template<typename>
+	struct ColumnsOf;
+
+	template<typename... Fields>
+	struct ColumnsOf<std::tuple<Fields...>> {
+		using type = std::tuple<std::pmr::vector<typename MemberType<Fields>::type>...>;
+	};
+
+};
+
+/**
+ * One contiguous column per field listed in T::Fields, rows follow the packed entities.
+ */
+template<typename T>
+class SoAStorage {
+public:
+	using FieldsTuple = std::remove_cv_t<decltype(T::Fields)>;
+	using Columns = typename SoAHelpers::ColumnsOf<FieldsTuple>::type;
+
+	static constexpr size_t FieldCount = std::tuple_size<FieldsTuple>::value;
+
+	SoAStorage() : m_Entities(RegistryAllocator(GetMemoryResource())), m_Columns(MakeColumns(std::make_index_sequence<FieldCount>{})) {
+
+	};
+
+	template<auto Field>
+	static constexpr size_t FieldIndex() {
+		return []<size_t... I>(std::index_sequence<I...>) {
+			size_t index = FieldCount;
+			((IsField<I, Field>() ? (index = I, true) : false) || ...);
+			return index;
+		}(std::make_index_sequence<FieldCount>{});
+	}
+
+	bool Contains(entt::entity e) const {
+		return m_Entities.contains(e);
+	}
+
+	size_t Size() const {
+		return m_Entities.size();
+	}
+
+	size_t Row(entt::entity e) const {
+		return m_Entities.index(e);
+	}
+
+	void Reserve(size_t count) {
+		m_Entities.reserve(count);
+		ForEachColumn([=](auto& column) {
+			column.reserve(count);
+		});
+	}
+
+	void Emplace(entt::entity e, const T& value) {
+		m_Entities.emplace(e);
+		[&]<size_t... I>(std::index_sequence<I...>) {
+			(std::get<I>(m_Columns).push_back(value.*std::get<I>(T::Fields)), ...);
+		}(std::make_index_sequence<FieldCount>{});
+	}
+
+	void Erase(entt::entity e) {
+		size_t row = Row(e);
+		size_t last = Size() - 1;
+		ForEachColumn([=](auto& column) {
+			column[row] = std::move(column[last]);
+			column.pop_back();
+		});
+		// the sparse set swaps the last entity into the erased row as well
+		m_Entities.erase(e);
+	}
+
+	void Clear() {
+		m_Entities.clear();
+		ForEachColumn([](auto& column) {
+			column.clear();
+		});
+	}
+
+	T Load(size_t row) const {
+		T value;
+		[&]<size_t... I>(std::index_sequence<I...>) {
+			((value.*std::get<I>(T::Fields) = std::get<I>(m_Columns)[row]), ...);
+		}(std::make_index_sequence<FieldCount>{});
+		return value;
+	}
+
+	void Store(size_t row, const T& value) {
+		[&]<size_t... I>(std::index_sequence<I...>) {
+			((std::get<I>(m_Columns)[row] = value.*std::get<I>(T::Fields)), ...);
+		}(std::make_index_sequence<FieldCount>{});
+	}
+
+	template<auto Field>
+	auto& At(size_t row) {
+		return Column<Field>()[row];
+	}
+
+	template<auto Field>
+	auto Column() {
+		static_assert(FieldIndex<Field>() < FieldCount, "Field is not listed in the Fields of the component!");
+		auto& column = std::get<FieldIndex<Field>()>(m_Columns);
+		return std::span(column.data(), column.size());
+	}
+
+	std::span<const entt::entity> Entities() const {
+		return { m_Entities.data(), m_Entities.size() };
+	}
+
+private:
+	template<size_t I, auto Field>
+	static constexpr bool IsField() {
+		if constexpr (std::is_same<decltype(Field), std::tuple_element_t<I, FieldsTuple>>::value) {
+			return std::get<I>(T::Fields) == Field;
+		}
+		else {
+			return false;
+		}
+	}
+
+	template<size_t... I>
+	static Columns MakeColumns(std::index_sequence<I...>) {
+		return Columns(std::tuple_element_t<I, Columns>(GetMemoryResource())...);
+	}
+
+	template<typename Func>
+	void ForEachColumn(Func&& func) {
+		std::apply([&](auto&... column) {
+			(func(column), ...);
+		}, m_Columns);
+	}
+
+	entt::basic_sparse_set<entt::entity, RegistryAllocator> m_Entities;
+	Columns m_Columns;
+
+};
+
+/**
+ * What GetComponent returns for SoA components, reads and writes go straight to the columns.
+ */
+template<typename T>
+class SoARef {
+public:
+	SoARef(SoAStorage<T>* storage, entt::entity e) {
+		m_Storage = storage;
+		m_MasterID = e;
+	};
+
+	template<auto Field>
+	auto& Get() {
+		return m_Storage->template At<Field>(m_Storage->Row(m_MasterID));
+	};
+
+	T Load() const {
+		return m_Storage->Load(m_Storage->Row(m_MasterID));
+	};
+
+	void Store(const T& value) {
+		m_Storage->Store(m_Storage->Row(m_MasterID), value);
+	};
+
+	entt::entity GetMasterHandle() const {
+		return m_MasterID;
+	};
+
+	operator bool() const {
+		return m_Storage && m_Storage->Contains(m_MasterID);
+	};
+
+private:
+	SoAStorage<T>* m_Storage = nullptr;
+	entt::entity m_MasterID = entt::null;
+
+};
+
+};
@@ -2,16 +2,69 @@
 
 #include "object/object.h"
 #include "object/tagged_object.h"
+#include "object/prefab.h"
+#include "object/query.h"
+#include "object/command_buffer.h"
 #include "components/component_specifier.h"
 #include "components/component.h"
 #include "components/add_only_to.h"
 #include "components/add_to_every_object.h"
+#include "systems/system.h"
+#include "helpers/memory.h"
 
 namespace ecspp {
 	inline void ClearDeletingQueue() {
 		ObjectPropertyRegister::ClearDeletingQueue();
 	};
 
+	inline bool ClearDeletingQueue(size_t maxObjects, std::chrono::nanoseconds maxTime = std::chrono::nanoseconds::max()) {
+		return ObjectPropertyRegister::ClearDeletingQueue(maxObjects, maxTime);
+	}
+
+	inline void UpdateAll(float deltaTime) {
+		ObjectPropertyRegister::UpdateAll(deltaTime);
+	}
+
+	inline Tick CurrentTick() {
+		return ObjectPropertyRegister::CurrentTick();
+	}
+
+	inline Tick AdvanceTick() {
+		return ObjectPropertyRegister::AdvanceTick();
+	}
+
+	template<typename T, typename Func>
+	inline size_t PropagateDown(Func&& combine, Tick since) {
+		return ObjectPropertyRegister::PropagateDown<T>(std::forward<Func>(combine), since);
+	}
+
+	template<typename T, typename... Args>
+	inline size_t AddComponentToAll(std::span<const entt::entity> entities, const Args&... args) {
+		return ObjectPropertyRegister::AddComponentToAll<T>(entities, args...);
+	}
+
+	template<typename T>
+	inline size_t EraseComponentFromAll(std::span<const entt::entity> entities) {
+		return ObjectPropertyRegister::EraseComponentFromAll<T>(entities);
+	}
+
+	template<typename T>
+	inline size_t ClearComponent() {
+		return ObjectPropertyRegister::ClearComponent<T>();
+	}
+
+	inline size_t AddComponentToAll(std::span<const entt::entity> entities, const std::string& componentName) {
+		return ObjectPropertyRegister::AddComponentToAllByName(entities, componentName);
+	}
+
+	inline size_t EraseComponentFromAll(std::span<const entt::entity> entities, const std::string& componentName) {
+		return ObjectPropertyRegister::EraseComponentFromAllByName(entities, componentName);
+	}
+
+	inline size_t ClearComponent(const std::string& componentName) {
+		return ObjectPropertyRegister::ClearComponentByName(componentName);
+	}
+
 	inline ObjectHandle CreateNewObject(std::string name) {
 		return ObjectPropertyRegister::CreateNew<Object>(name);
 	}
@@ -74,8 +127,8 @@ namespace ecspp {
 	}
 
 	inline void DeleteAllObjects() {
-		Object::ForEach([](Object obj) {
-			ecspp::DeleteObject(obj);
+		Registry().each([](entt::entity e) {
+			ecspp::DeleteObject(e);
 			});
 
 
@@ -12,6 +12,23 @@
 #include "../vendor/entt/single_include/entt/entt.hpp"
 
 
+#ifndef ECSPP_MAX_COMPONENT_TYPES
+#define ECSPP_MAX_COMPONENT_TYPES 256
+#endif
+
+#ifndef ECSPP_MAX_FIXED_UPDATE_STEPS
+#define ECSPP_MAX_FIXED_UPDATE_STEPS 8
+#endif
+
+#ifndef ECSPP_MAX_WORLD_CONTEXTS
+#define ECSPP_MAX_WORLD_CONTEXTS 32
+#endif
+
+#ifndef ECSPP_PARALLEL_CLONE_THRESHOLD
+#define ECSPP_PARALLEL_CLONE_THRESHOLD 4096
+#endif
+
+
 #ifdef NDEBUG
 #define ECSPP_DEBUG_LOG(x)
 #define ECSPP_DEBUG_WARN(x)
@@ -1,6 +1,7 @@
 #pragma once
 #include "../global.h"
 #include <variant>
+#include <mutex>
 
 
 
@@ -96,16 +97,20 @@ public:
 
     template<typename T>
     static entt::id_type HashClassName() {
-        entt::id_type hash = entt::hashed_string(GetClassName<T>().c_str());
-        if (m_ClassHashPerNameHash.find(hash) == m_ClassHashPerNameHash.end()) {
-            m_ClassHashPerNameHash[hash] = entt::type_id<T>().hash();
-        }
+        // computed once per type, command buffers and worlds call this from worker threads
+        static const entt::id_type hash = []() {
+            entt::id_type nameHash = entt::hashed_string(GetClassName<T>().c_str());
+            std::lock_guard<std::mutex> lock(m_ClassHashMutex);
+            m_ClassHashPerNameHash[nameHash] = entt::type_id<T>().hash();
+            return nameHash;
+        }();
         return hash;
     }
 
     static entt::id_type GetClassHash(entt::id_type nameHash) {
-        if (m_ClassHashPerNameHash.find(nameHash) != m_ClassHashPerNameHash.end()) {
-            return m_ClassHashPerNameHash[nameHash];
+        std::lock_guard<std::mutex> lock(m_ClassHashMutex);
+        if (auto it = m_ClassHashPerNameHash.find(nameHash); it != m_ClassHashPerNameHash.end()) {
+            return it->second;
         }
         return {};
     }
@@ -114,6 +119,7 @@ public:
     
 private:
     static inline std::unordered_map<entt::id_type, entt::id_type> m_ClassHashPerNameHash;
+    static inline std::mutex m_ClassHashMutex;
 public:
 
     template<typename... Args>
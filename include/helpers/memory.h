@@ -0,0 +1,54 @@
+#pragma once
+#include <memory_resource>
+#include <cstddef>
+#include <new>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+
+namespace ecspp {
+
+/**
+ * Memory resource backed by transparent huge pages, meant as the upstream of a std::pmr pool.
+ */
+class HugePageResource : public std::pmr::memory_resource {
+public:
+	static constexpr size_t HugePageSize = 2 * 1024 * 1024;
+
+private:
+	static size_t RoundUp(size_t bytes) {
+		return (bytes + HugePageSize - 1) / HugePageSize * HugePageSize;
+	}
+
+	void* do_allocate(size_t bytes, size_t alignment) override {
+#if defined(__linux__)
+		size_t size = RoundUp(bytes);
+		void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (ptr == MAP_FAILED) {
+			throw std::bad_alloc();
+		}
+#if defined(MADV_HUGEPAGE)
+		madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+		return ptr;
+#else
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+#endif
+	}
+
+	void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+#if defined(__linux__)
+		munmap(ptr, RoundUp(bytes));
+#else
+		std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+#endif
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+
+};
+
+};
@@ -0,0 +1,131 @@
+#pragma once
+#include "../global.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+
+
+namespace ecspp {
+
+/**
+ * Fixed size work stealing pool, one task deque per worker.
+ */
+class ThreadPool {
+public:
+	ThreadPool(size_t threadCount = std::thread::hardware_concurrency()) {
+		if (threadCount == 0) {
+			threadCount = 1;
+		}
+
+		for (size_t i = 0; i < threadCount; i++) {
+			m_Workers.push_back(std::make_unique<Worker>());
+		}
+		for (size_t i = 0; i < threadCount; i++) {
+			m_Threads.emplace_back([this, i]() {
+				Run(i);
+			});
+		}
+	};
+
+	~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(m_SleepMutex);
+			m_Stopping = true;
+		}
+		m_Wake.notify_all();
+
+		for (auto& thread : m_Threads) {
+			thread.join();
+		}
+	};
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	void Submit(std::function<void()> task) {
+		size_t queueIndex = (t_CurrentPool == this) ? t_CurrentWorker : (m_NextQueue++ % m_Workers.size());
+
+		{
+			std::lock_guard<std::mutex> lock(m_Workers[queueIndex]->m_Mutex);
+			m_Workers[queueIndex]->m_Tasks.push_back(std::move(task));
+		}
+		{
+			std::lock_guard<std::mutex> lock(m_SleepMutex);
+			m_Pending++;
+		}
+		m_Wake.notify_one();
+	}
+
+	size_t GetNumberOfThreads() const {
+		return m_Threads.size();
+	}
+
+private:
+	struct Worker {
+		std::deque<std::function<void()>> m_Tasks;
+		std::mutex m_Mutex;
+	};
+
+	bool TryPop(size_t index, std::function<void()>& task) {
+		Worker& worker = *m_Workers[index];
+		std::lock_guard<std::mutex> lock(worker.m_Mutex);
+		if (worker.m_Tasks.empty()) {
+			return false;
+		}
+		task = std::move(worker.m_Tasks.back());
+		worker.m_Tasks.pop_back();
+		return true;
+	}
+
+	bool TrySteal(size_t thief, std::function<void()>& task) {
+		for (size_t offset = 1; offset < m_Workers.size(); offset++) {
+			Worker& victim = *m_Workers[(thief + offset) % m_Workers.size()];
+			std::lock_guard<std::mutex> lock(victim.m_Mutex);
+			if (!victim.m_Tasks.empty()) {
+				task = std::move(victim.m_Tasks.front());
+				victim.m_Tasks.pop_front();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void Run(size_t index) {
+		t_CurrentPool = this;
+		t_CurrentWorker = index;
+
+		while (true) {
+			std::function<void()> task;
+			if (TryPop(index, task) || TrySteal(index, task)) {
+				m_Pending--;
+				task();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(m_SleepMutex);
+			m_Wake.wait(lock, [this]() {
+				return m_Stopping || m_Pending > 0;
+			});
+			if (m_Stopping && m_Pending == 0) {
+				return;
+			}
+		}
+	}
+
+	std::vector<std::unique_ptr<Worker>> m_Workers;
+	std::vector<std::thread> m_Threads;
+
+	std::mutex m_SleepMutex;
+	std::condition_variable m_Wake;
+	std::atomic<size_t> m_Pending = 0;
+	std::atomic<size_t> m_NextQueue = 0;
+	bool m_Stopping = false;
+
+	static inline thread_local ThreadPool* t_CurrentPool = nullptr;
+	static inline thread_local size_t t_CurrentWorker = 0;
+
+};
+
+};
@@ -0,0 +1,348 @@
+#pragma once
+#include "object.h"
+#include <mutex>
+#include <algorithm>
+
+
+namespace ecspp {
+
+class CommandBuffer;
+
+/**
+ * Placeholder for an object created through a command buffer, usable as a target by later commands.
+ */
+struct PendingObject {
+	CommandBuffer* m_Buffer = nullptr;
+	uint32_t m_Index = 0;
+	// placeholders from before the buffer was cleared resolve to null instead of to a newer creation
+	uint32_t m_Generation = 0;
+};
+
+struct CommandTarget {
+	CommandTarget(entt::entity e) : m_Entity(e) {};
+
+	CommandTarget(PendingObject pending) : m_Pending(pending) {};
+
+	entt::entity m_Entity = entt::null;
+	PendingObject m_Pending;
+};
+
+/**
+ * Records structural changes and applies them batched per type at a sync point.
+ * Order: creations, renames, parenting, component erasures, component additions, destructions.
+ */
+class CommandBuffer {
+public:
+	template<typename T>
+	PendingObject Create(std::string name) {
+		static_assert(std::is_base_of<Object, T>::value);
+
+		m_Creates.push_back({ HelperFunctions::HashClassName<T>(), std::move(name), &CreateObjects<T> });
+		return { this, static_cast<uint32_t>(m_Creates.size() - 1), m_Generation };
+	};
+
+	void Destroy(CommandTarget target) {
+		m_Destroys.push_back(target);
+	};
+
+	/**
+	 * Without arguments the component is default constructed, otherwise from a copy built now with args.
+	 */
+	template<typename T, typename... Args>
+	void AddComponent(CommandTarget target, Args&&... args) {
+		std::shared_ptr<void> value;
+		if constexpr (sizeof...(Args) > 0) {
+			value = std::make_shared<T>(std::forward<Args>(args)...);
+		}
+		m_ComponentAdds.push_back({ target, ObjectPropertyRegister::GetComponentIndex<T>(), std::move(value) });
+	};
+
+	bool AddComponentByName(CommandTarget target, const std::string& componentName) {
+		ComponentIndex index = ObjectPropertyRegister::GetComponentIndexByName(componentName);
+		if (index == NullComponentIndex) {
+			return false;
+		}
+		m_ComponentAdds.push_back({ target, index, nullptr });
+		return true;
+	};
+
+	template<typename T>
+	void EraseComponent(CommandTarget target) {
+		m_ComponentErases.push_back({ target, ObjectPropertyRegister::GetComponentIndex<T>(), nullptr });
+	};
+
+	bool EraseComponentByName(CommandTarget target, const std::string& componentName) {
+		ComponentIndex index = ObjectPropertyRegister::GetComponentIndexByName(componentName);
+		if (index == NullComponentIndex) {
+			return false;
+		}
+		m_ComponentErases.push_back({ target, index, nullptr });
+		return true;
+	};
+
+	void SetParent(CommandTarget child, CommandTarget parent) {
+		m_Parents.push_back({ child, parent });
+	};
+
+	void SetName(CommandTarget target, std::string name) {
+		m_Renames.push_back({ target, std::move(name) });
+	};
+
+	bool Empty() const {
+		return m_Creates.empty() && m_Destroys.empty() && m_ComponentAdds.empty() && m_ComponentErases.empty() && m_Parents.empty() && m_Renames.empty();
+	};
+
+	/**
+	 * Applies and clears the commands of this buffer only.
+	 */
+	void Playback() {
+		CommandBuffer* buffers[] = { this };
+		Playback(buffers);
+	};
+
+	/**
+	 * Applies and clears several buffers together, so that component commands from all of them are batched.
+	 */
+	static void Playback(std::span<CommandBuffer* const> buffers) {
+		for (auto buffer : buffers) {
+			buffer->PlaybackCreates();
+		}
+
+		for (auto buffer : buffers) {
+			for (auto& [target, name] : buffer->m_Renames) {
+				if (entt::entity e = Resolve(target); Registry().valid(e)) {
+					ObjectPropertyRegister::SetObjectName(e, name);
+				}
+			}
+		}
+
+		for (auto buffer : buffers) {
+			for (auto& [child, parent] : buffer->m_Parents) {
+				entt::entity childEntity = Resolve(child);
+				entt::entity parentEntity = Resolve(parent);
+				if (Registry().valid(childEntity) && Registry().valid(parentEntity)) {
+					Object(childEntity).SetParent(Object(parentEntity));
+				}
+			}
+		}
+
+		std::vector<ResolvedComponentCommand> erases = ResolveComponentCommands(buffers, &CommandBuffer::m_ComponentErases);
+		ForEachTypeRun(erases, [](ComponentIndex index, std::span<ResolvedComponentCommand> run, const std::vector<entt::entity>& entities) {
+			ObjectPropertyRegister::GetComponentTypeInfo(index).m_EraseRange(entities.data(), entities.data() + entities.size());
+		});
+
+		std::vector<ResolvedComponentCommand> adds = ResolveComponentCommands(buffers, &CommandBuffer::m_ComponentAdds);
+		ForEachTypeRun(adds, [](ComponentIndex index, std::span<ResolvedComponentCommand> run, const std::vector<entt::entity>& entities) {
+			const ComponentTypeInfo& info = ObjectPropertyRegister::GetComponentTypeInfo(index);
+
+			// one reserve and bulk insert for the whole run, the commands carrying a value then overwrite theirs
+			info.m_CreateRange(entities.data(), entities.data() + entities.size());
+			for (auto& command : run) {
+				if (command.m_Value) {
+					info.m_CopyToRange(command.m_Value.get(), &command.m_Entity, &command.m_Entity + 1);
+				}
+			}
+		});
+
+		// only the recorded targets go, a budgeted deletion in progress keeps its own pace
+		std::vector<entt::entity> destroys;
+		for (auto buffer : buffers) {
+			for (auto& target : buffer->m_Destroys) {
+				if (entt::entity e = Resolve(target); Registry().valid(e)) {
+					destroys.push_back(e);
+				}
+			}
+		}
+		if (!destroys.empty()) {
+			ObjectPropertyRegister::DestroySubtrees(destroys);
+		}
+
+		for (auto buffer : buffers) {
+			buffer->Clear();
+		}
+	};
+
+	void Clear() {
+		m_Generation++;
+		m_Creates.clear();
+		m_CreatedEntities.clear();
+		m_Destroys.clear();
+		m_ComponentAdds.clear();
+		m_ComponentErases.clear();
+		m_Parents.clear();
+		m_Renames.clear();
+	};
+
+private:
+	using CreateFunction = void(*)(size_t, const std::string&, entt::entity*);
+
+	struct CreateCommand {
+		entt::id_type m_Type;
+		std::string m_Name;
+		CreateFunction m_Create;
+	};
+
+	struct ComponentCommand {
+		CommandTarget m_Target;
+		ComponentIndex m_Index;
+		std::shared_ptr<void> m_Value;
+	};
+
+	struct ResolvedComponentCommand {
+		entt::entity m_Entity;
+		ComponentIndex m_Index;
+		std::shared_ptr<void> m_Value;
+	};
+
+	template<typename T>
+	static void CreateObjects(size_t count, const std::string& name, entt::entity* out) {
+		std::vector<T> objects = ObjectPropertyRegister::CreateMany<T>(count, name);
+		for (size_t i = 0; i < count; i++) {
+			out[i] = objects[i].ID();
+		}
+	};
+
+	static entt::entity Resolve(const CommandTarget& target) {
+		if (target.m_Pending.m_Buffer == nullptr) {
+			return target.m_Entity;
+		}
+		if (target.m_Pending.m_Generation != target.m_Pending.m_Buffer->m_Generation) {
+			return entt::null;
+		}
+		const std::vector<entt::entity>& created = target.m_Pending.m_Buffer->m_CreatedEntities;
+		return target.m_Pending.m_Index < created.size() ? created[target.m_Pending.m_Index] : entt::entity(entt::null);
+	};
+
+	void PlaybackCreates() {
+		m_CreatedEntities.assign(m_Creates.size(), entt::null);
+
+		std::vector<uint32_t> order(m_Creates.size());
+		for (uint32_t i = 0; i < order.size(); i++) {
+			order[i] = i;
+		}
+		std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+			if (m_Creates[a].m_Type != m_Creates[b].m_Type) {
+				return m_Creates[a].m_Type < m_Creates[b].m_Type;
+			}
+			return m_Creates[a].m_Name < m_Creates[b].m_Name;
+		});
+
+		// objects of the same type and name are created together with CreateMany
+		std::vector<entt::entity> entities;
+		for (size_t begin = 0; begin < order.size();) {
+			const CreateCommand& command = m_Creates[order[begin]];
+			size_t end = begin + 1;
+			while (end < order.size() && m_Creates[order[end]].m_Type == command.m_Type && m_Creates[order[end]].m_Name == command.m_Name) {
+				end++;
+			}
+
+			entities.resize(end - begin);
+			command.m_Create(entities.size(), command.m_Name, entities.data());
+			for (size_t i = begin; i < end; i++) {
+				m_CreatedEntities[order[i]] = entities[i - begin];
+			}
+			begin = end;
+		}
+	};
+
+	static std::vector<ResolvedComponentCommand> ResolveComponentCommands(std::span<CommandBuffer* const> buffers, std::vector<ComponentCommand> CommandBuffer::* commands) {
+		std::vector<ResolvedComponentCommand> resolved;
+		for (auto buffer : buffers) {
+			for (auto& command : buffer->*commands) {
+				if (entt::entity e = Resolve(command.m_Target); Registry().valid(e)) {
+					resolved.push_back({ e, command.m_Index, command.m_Value });
+				}
+			}
+		}
+		std::stable_sort(resolved.begin(), resolved.end(), [](const ResolvedComponentCommand& a, const ResolvedComponentCommand& b) {
+			return a.m_Index < b.m_Index;
+		});
+		return resolved;
+	};
+
+	template<typename Func>
+	static void ForEachTypeRun(std::vector<ResolvedComponentCommand>& commands, Func&& func) {
+		std::vector<entt::entity> entities;
+		for (size_t begin = 0; begin < commands.size();) {
+			size_t end = begin;
+			entities.clear();
+			while (end < commands.size() && commands[end].m_Index == commands[begin].m_Index) {
+				entities.push_back(commands[end].m_Entity);
+				end++;
+			}
+			func(commands[begin].m_Index, std::span<ResolvedComponentCommand>(commands.data() + begin, end - begin), entities);
+			begin = end;
+		}
+	};
+
+	std::vector<CreateCommand> m_Creates;
+	uint32_t m_Generation = 0;
+	std::vector<entt::entity> m_CreatedEntities;
+	std::vector<CommandTarget> m_Destroys;
+	std::vector<ComponentCommand> m_ComponentAdds;
+	std::vector<ComponentCommand> m_ComponentErases;
+	std::vector<std::pair<CommandTarget, CommandTarget>> m_Parents;
+	std::vector<std::pair<CommandTarget, std::string>> m_Renames;
+
+};
+
+/**
+ * Hands every thread of a world its own CommandBuffer, only the first use on a thread takes a lock.
+ */
+class CommandQueue {
+public:
+	CommandQueue() : m_ID(NextID()++) {
+
+	};
+
+	CommandBuffer& Local() {
+		thread_local std::unordered_map<uint64_t, CommandBuffer*> buffers;
+
+		CommandBuffer*& buffer = buffers[m_ID];
+		if (!buffer) {
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			buffer = m_Buffers.emplace_back(std::make_unique<CommandBuffer>()).get();
+		}
+		return *buffer;
+	};
+
+	/**
+	 * Applies the buffers of every thread, no thread may be recording meanwhile.
+	 */
+	void Playback() {
+		std::vector<CommandBuffer*> buffers;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			for (auto& buffer : m_Buffers) {
+				if (!buffer->Empty()) {
+					buffers.push_back(buffer.get());
+				}
+			}
+		}
+		CommandBuffer::Playback(buffers);
+	};
+
+private:
+	static std::atomic<uint64_t>& NextID() {
+		static std::atomic<uint64_t> id = 0;
+		return id;
+	};
+
+	uint64_t m_ID;
+	std::mutex m_Mutex;
+	std::vector<std::unique_ptr<CommandBuffer>> m_Buffers;
+
+};
+
+/**
+ * Command buffer of the calling thread in the current world.
+ */
+inline CommandBuffer& Commands() {
+	return World::Current().Context<CommandQueue>().Local();
+}
+
+inline void PlaybackCommands() {
+	World::Current().Context<CommandQueue>().Playback();
+}
+
+};
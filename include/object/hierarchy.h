@@ -0,0 +1,136 @@
+#pragma once
+#include "registry.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <vector>
+
+
+namespace ecspp {
+
+class ObjectProperties;
+
+/**
+ * Parent/child links of the current world flattened in depth first order, rebuilt lazily after they change.
+ * Code touching a single subtree walks the links itself, a lookup here after a change rebuilds the whole world.
+ */
+class Hierarchy {
+public:
+	static void MarkDirty() {
+		State().m_Dirty.store(true, std::memory_order_release);
+	}
+
+	/**
+	 * True when ancestor is a parent, grandparent and so on of e.
+	 */
+	static bool IsDescendantOf(entt::entity e, entt::entity ancestor) {
+		HierarchyState& state = Built();
+		uint32_t position = 0, ancestorPosition = 0;
+		if (!Find(state, e, position) || !Find(state, ancestor, ancestorPosition)) {
+			return false;
+		}
+		return ancestorPosition < position && position < state.m_SubtreeEnd[ancestorPosition];
+	}
+
+	/**
+	 * Every descendant of root, parents before their children.
+	 */
+	static std::span<const entt::entity> Descendants(entt::entity root) {
+		HierarchyState& state = Built();
+		uint32_t position = 0;
+		if (!Find(state, root, position)) {
+			return {};
+		}
+		return std::span<const entt::entity>(state.m_Order.data() + position + 1, state.m_SubtreeEnd[position] - position - 1);
+	}
+
+	/**
+	 * Number of ancestors of e, zero for objects without a parent.
+	 */
+	static uint32_t Depth(entt::entity e) {
+		HierarchyState& state = Built();
+		uint32_t position = 0;
+		if (!Find(state, e, position)) {
+			return 0;
+		}
+		return state.m_Depth[position];
+	}
+
+	/**
+	 * Calls func(e, parent) once for every object in the subtrees of roots, parents before their children.
+	 */
+	template<typename Func>
+	static void ForEachInSubtrees(std::span<const entt::entity> roots, Func&& func) {
+		HierarchyState& state = Built();
+
+		std::vector<uint32_t> positions;
+		positions.reserve(roots.size());
+		for (auto root : roots) {
+			if (uint32_t position = 0; Find(state, root, position)) {
+				positions.push_back(position);
+			}
+			else {
+				// not linked to anything since the last rebuild
+				func(root, entt::entity(entt::null));
+			}
+		}
+		std::sort(positions.begin(), positions.end());
+
+		uint32_t covered = 0;
+		for (auto position : positions) {
+			if (position < covered) {
+				continue;
+			}
+			covered = state.m_SubtreeEnd[position];
+			for (uint32_t current = position; current < covered; current++) {
+				func(state.m_Order[current], state.m_Parent[current]);
+			}
+		}
+	}
+
+private:
+	struct HierarchyState {
+		std::vector<entt::entity> m_Order;
+		std::vector<entt::entity> m_Parent;
+		std::vector<uint32_t> m_SubtreeEnd;
+		std::vector<uint32_t> m_Depth;
+		// indexed by entity index, only trusted when the entity stored at that position matches
+		std::vector<uint32_t> m_PositionByIndex;
+		std::atomic<bool> m_Dirty = true;
+		std::mutex m_RebuildMutex;
+	};
+
+	static HierarchyState& State() {
+		return World::Current().Context<HierarchyState>();
+	}
+
+	static HierarchyState& Built() {
+		HierarchyState& state = State();
+		// lookups may come from parallel systems, only one of them rebuilds
+		if (state.m_Dirty.load(std::memory_order_acquire)) {
+			std::lock_guard<std::mutex> lock(state.m_RebuildMutex);
+			if (state.m_Dirty.load(std::memory_order_relaxed)) {
+				Rebuild(state);
+				state.m_Dirty.store(false, std::memory_order_release);
+			}
+		}
+		return state;
+	}
+
+	static bool Find(const HierarchyState& state, entt::entity e, uint32_t& position) {
+		auto index = entt::to_entity(e);
+		if (index >= state.m_PositionByIndex.size()) {
+			return false;
+		}
+		position = state.m_PositionByIndex[index];
+		return position < state.m_Order.size() && state.m_Order[position] == e;
+	}
+
+	// defined after ObjectProperties
+	static void Rebuild(HierarchyState& state);
+
+};
+
+};
@@ -20,31 +20,24 @@ public:
             ECSPP_DEBUG_ERROR("Passing an invalid entity!!!");
         }
         m_EntityHandle = ent;
+        m_World = &World::Current();
     }
     ~Object() {};
 
 
     template<typename T>
     bool HasComponent() {
-
-        return ObjectPropertyRegister::HasComponent<T>(m_EntityHandle);
+        if constexpr (IsSoAComponent<T>) {
+            return ObjectPropertyRegister::HasSoAComponent<T>(m_EntityHandle);
+        }
+        else {
+            return ObjectPropertyRegister::HasComponent<T>(m_EntityHandle);
+        }
     }
 
     bool HasComponent(std::string type) {
 
-        auto resolved = entt::resolve(entt::hashed_string(type.c_str()));
-
-        if (resolved) {
-            if (auto func = resolved.func(entt::hashed_string("Has Component")); func) {
-                return *((bool*)func.invoke({}, this->ID()).data());
-            }
-            else {
-                return false;
-            }
-        }
-        else {
-            return false;
-        }
+        return Properties().m_ComponentMask.Test(ObjectPropertyRegister::GetComponentIndexByName(type));
 
     }
 
@@ -89,46 +82,90 @@ public:
     };
 
     void Update(float deltaTime) {
-        for (auto& name : GetComponentsNames()) {
-            HelperFunctions::CallMetaFunction(name,"Update Component",this->ID(),deltaTime);
+        for (auto index : GetComponentsIndices()) {
+            ObjectPropertyRegister::GetComponentTypeInfo(index).m_Update(m_EntityHandle, deltaTime);
         }
     };
     
 
+    /**
+     * Returns T&, or a SoARef<T> for SoA components, and marks the component changed.
+     */
     template<typename T>
-    T& GetComponent() {
-        return *ObjectPropertyRegister::GetComponent<T>(m_EntityHandle);
+    decltype(auto) GetComponent() {
+        if constexpr (IsSoAComponent<T>) {
+            return ObjectPropertyRegister::AddSoAComponent<T>(m_EntityHandle);
+        }
+        else {
+            T* comp = ObjectPropertyRegister::GetComponent<T>(m_EntityHandle);
+            ObjectPropertyRegister::MarkComponentChanged<T>(m_EntityHandle);
+            return *comp;
+        }
+    }
+
+    /**
+     * Read only access that neither adds the component nor marks it changed, systems declaring Reads<T> use this.
+     */
+    template<typename T>
+    const T& ReadComponent() const {
+        static_assert(!IsSoAComponent<T>, "Structure of arrays components are read through GetComponent");
+        const T* comp = Registry().try_get<T>(m_EntityHandle);
+        if (!comp) {
+            throw std::runtime_error("Reading component " + HelperFunctions::GetClassName<T>() + " the object does not have!");
+        }
+        return *comp;
+    }
+
+    /**
+     * Returns a handle caching the address of the component, it does not add the component.
+     */
+    template<typename T>
+    ComponentRef<T> GetComponentRef() {
+        return ComponentRef<T>(m_EntityHandle);
+    }
+
+    /**
+     * Applies func to the component and marks it as changed.
+     */
+    template<typename T,typename Func>
+    void Patch(Func&& func) {
+        func(GetComponent<T>());
+    }
+
+    /**
+     * Marks the component as changed for queries using Changed<T>, for writes that bypassed GetComponent.
+     */
+    template<typename T>
+    void MarkDirty() {
+        ObjectPropertyRegister::MarkComponentChanged<T>(m_EntityHandle);
     }
 
 
     void SetName(std::string name){
-        Properties().SetName(name);
+        ObjectPropertyRegister::SetObjectName(m_EntityHandle, name);
     }
 
     
 
     bool CopyComponentByName(std::string stringToHash,Object from){
-        auto resolved = entt::resolve(entt::hashed_string(stringToHash.c_str()));
-        
-        if(resolved){
-            entt::meta_any component = resolved.construct(*this);
-            if(auto func = resolved.func(entt::hashed_string("Copy Component")) ; func){
-                return func.invoke({},from.ID(), this->ID()).operator bool();
-            }
-            else{
-                return false;
-            }
-        }
-        else{
+        ComponentIndex index = ObjectPropertyRegister::GetComponentIndexByName(stringToHash);
+
+        if(index == NullComponentIndex){
             return false;
         }
+        return ObjectPropertyRegister::GetComponentTypeInfo(index).m_Copy(from.ID(), this->ID());
     };
 
     
 
     template<typename T,typename ...Args>
-    T& AddComponent(Args&&... args){
-        return *ObjectPropertyRegister::GetComponent<T, Args...>(m_EntityHandle, std::forward<Args>(args)...);
+    decltype(auto) AddComponent(Args&&... args){
+        if constexpr (IsSoAComponent<T>) {
+            return ObjectPropertyRegister::AddSoAComponent<T>(m_EntityHandle, T(std::forward<Args>(args)...));
+        }
+        else {
+            return *ObjectPropertyRegister::GetComponent<T, Args...>(m_EntityHandle, std::forward<Args>(args)...);
+        }
     }
 
   
@@ -145,32 +182,21 @@ public:
 
     template<typename T>
     bool EraseComponent(){
-        bool val = ObjectPropertyRegister::EraseComponent<T>(m_EntityHandle);
-        Properties().SetComponentsNames(ObjectPropertyRegister::GetObjectComponents(m_EntityHandle));
-      
-        return val;
+        if constexpr (IsSoAComponent<T>) {
+            return ObjectPropertyRegister::EraseSoAComponent<T>(m_EntityHandle);
+        }
+        else {
+            return ObjectPropertyRegister::EraseComponent<T>(m_EntityHandle);
+        }
     };
 
     bool EraseComponentByName(std::string componentName){
-        auto resolved = entt::resolve(entt::hashed_string(componentName.c_str()));
-        
-        if(resolved){
-            if(auto func = resolved.func(entt::hashed_string("Erase Component")) ; func){
-                if (func.invoke({}, m_EntityHandle)) {
-                    Properties().SetComponentsNames(ObjectPropertyRegister::GetObjectComponents(m_EntityHandle));
-                    return true;
-                }
-                else {
-                    return false;
-                }
-            }
-            else{
-                return false;
-            }
-        }
-        else{
+        ComponentIndex index = ObjectPropertyRegister::GetComponentIndexByName(componentName);
+
+        if(index == NullComponentIndex){
             return false;
         }
+        return ObjectPropertyRegister::GetComponentTypeInfo(index).m_Erase(m_EntityHandle);
     }
 
     bool Valid(){
@@ -187,11 +213,12 @@ public:
     
     template<typename T>
     static bool CopyComponent(Object from,Object to){
-        if (ObjectPropertyRegister::CopyComponent<T>(from.ID(), to.ID())) {
-            to.Properties().SetComponentsNames(ObjectPropertyRegister::GetObjectComponents(to.m_EntityHandle));
-            return true;
+        if constexpr (IsSoAComponent<T>) {
+            return ObjectPropertyRegister::CopySoAComponent<T>(from.ID(), to.ID());
+        }
+        else {
+            return ObjectPropertyRegister::CopyComponent<T>(from.ID(), to.ID());
         }
-        return false;
     };
 
     bool HasSameObjectTypeAs(Object other) {
@@ -212,18 +239,12 @@ public:
     };
     
     bool Empty() {
-        bool found = false;
-        ForEachComponent([&](auto handle) {
-            found = true;
-
-            });
-        return !found;
+        return Properties().m_ComponentMask.None();
     }
 
     void ClearParent() {
         if (Properties().m_Parent) {
             Properties().m_Parent.GetAs<Object>().Properties().RemoveChildren(this->Properties());
-            Properties().m_Parent = ObjectHandle();
         }
     }
 
@@ -241,37 +262,39 @@ public:
     }
 
     bool IsInChildren(Object object) const {
-        ObjectHandle handle(object.ID());
-        if (Properties().m_Children.size() == 0) {
-            return false;
-        }
-        auto it = std::find(Properties().m_Children.begin(), Properties().m_Children.end(), handle);
-        if (it != Properties().m_Children.end()) {
-            return true;
-        }
-        for (auto& id : Properties().m_Children) {
-            if (id.GetAs<Object>().IsInChildren(object)) {
-                return true;
-            }
-        }
-        return false;
+        return Hierarchy::IsDescendantOf(object.ID(), m_EntityHandle);
+    }
+
+    /**
+     * Descendants in depth first order, valid until the links change.
+     */
+    std::span<const entt::entity> GetDescendants() const {
+        return Hierarchy::Descendants(m_EntityHandle);
+    }
+
+    uint32_t GetDepth() const {
+        return Hierarchy::Depth(m_EntityHandle);
     }
 
     ObjectHandle GetParent() const {
         return Properties().GetParent();
     }
 
-    const std::vector<ObjectHandle>& GetChildren() const {
+    const std::pmr::vector<ObjectHandle>& GetChildren() const {
         return Properties().GetChildren();
     }
 
-    const std::vector< std::string>& GetComponentsNames() const {
-        return Properties().GetComponentsNames();
+    std::vector<std::string> GetComponentsNames() const {
+        return ObjectPropertyRegister::GetObjectComponents(m_EntityHandle);
+    }
+
+    const ComponentIndexList& GetComponentsIndices() const {
+        return Properties().GetComponentIndices();
     }
 
     void ForEachComponent(std::function<void(ComponentHandle&)> func) {
-        for (auto& componentName : GetComponentsNames()) {
-            ComponentHandle comp = ObjectPropertyRegister::GetComponentByName(this->ID(), componentName);
+        for (auto index : GetComponentsIndices()) {
+            ComponentHandle comp(m_EntityHandle, ObjectPropertyRegister::GetComponentTypeInfo(index).m_NameHash, index);
             if (comp) {
                 func(comp);
             }
@@ -295,11 +318,14 @@ public:
     }
    
     std::string GetName() {
-        return Properties().m_Name;
+        return Properties().GetName();
     }
 
     static void ForEach(std::function<void(Object)> func) {
         Registry().each([&](const entt::entity e) {
+            if (Registry().any_of<ParkedObject, PendingDeletion>(e)) {
+                return;
+            }
 
             func(Object(e));
 
@@ -309,14 +335,8 @@ public:
 
     
 	void ForSelfAndEachChild(std::function<void(Object)> func) {
-		func(*this);
-		if (GetChildren().size() == 0) {
-			return;
-		}
-		for (auto id : GetChildren()) {
-			if(id){
-				id.GetAsObject().ForSelfAndEachChild(func);
-			}
+		for (auto e : GetSelfAndDescendants()) {
+			func(Object(e));
 		}
 	};
 
@@ -326,7 +346,13 @@ public:
     
 
 protected:
-   
+    // a copy, func may reparent objects and the flattened order is rebuilt on the next lookup
+    std::vector<entt::entity> GetSelfAndDescendants() const {
+        auto descendants = GetDescendants();
+        std::vector<entt::entity> entities = { m_EntityHandle };
+        entities.insert(entities.end(), descendants.begin(), descendants.end());
+        return entities;
+    }
     
 
 
@@ -335,12 +361,19 @@ protected:
     
 private:
     ObjectProperties& Properties() const{
+#ifndef NDEBUG
+        // entities are only indices, under another world they would silently name some other object
+        if (m_World != &World::Current()) {
+            throw std::runtime_error("Using object with id " + std::to_string((uint32_t)m_EntityHandle) + " outside of the World it was obtained in!");
+        }
+#endif
         return Registry().get<ObjectProperties>(m_EntityHandle);
     };
 
     
 
     entt::entity m_EntityHandle;
+    World* m_World = nullptr;
     
     friend class ObjectPropertyRegister;
 
@@ -376,14 +409,6 @@ inline T<Object> ObjectHandle::GetAs() const{
     return { m_Handle };
 }
 
-inline void ObjectPropertyRegister::RegisterComponentsNames(entt::entity e) {
-    if (!ObjectHandle(e)) {
-        return;
-    }
-
-    Object(e).Properties().SetComponentsNames(ObjectPropertyRegister::GetObjectComponents(e));
-}
-
 template<typename T>
 inline auto ObjectPropertyRegister::CallVirtualFunc(entt::entity e, std::function<entt::meta_any(Object*)> func) {
     T obj(e);
@@ -393,20 +418,30 @@ inline auto ObjectPropertyRegister::CallVirtualFunc(entt::entity e, std::functio
 
 template<typename T>
 inline void ObjectPropertyRegister::UpdateComponent(entt::entity e, float deltaTime) {
-    if (!ObjectHandle(e)) {
-        return;
+    if constexpr (IsVirtualComponent<T>) {
+        if (!ObjectHandle(e)) {
+            return;
+        }
+        // reads go around Object::GetComponent so they don't mark the component changed
+        if (T* comp = GetComponent<T>(e)) {
+            static_cast<Component*>(comp)->Update(deltaTime);
+        }
     }
-    dynamic_cast<Component*>(&Object(e).GetComponent<T>())->Update(deltaTime);
 
 }
 
 template<typename T>
 inline Component* ObjectPropertyRegister::CastComponentToCommonBase(entt::entity e) {
-    if (!ObjectHandle(e)) {
+    if constexpr (!IsVirtualComponent<T>) {
         return nullptr;
     }
+    else {
+        if (!ObjectHandle(e)) {
+            return nullptr;
+        }
 
-    return (Component*) & Object(e).GetComponent<T>();
+        return static_cast<Component*>(GetComponent<T>(e));
+    }
 }
 
 template<typename MainComponentType, typename FinalType>
@@ -415,7 +450,7 @@ inline FinalType* ObjectPropertyRegister::CastComponentTo(entt::entity e) {
         return nullptr;
     }
 
-    return (FinalType*) & Object(e).GetComponent<MainComponentType>();
+    return (FinalType*)GetComponent<MainComponentType>(e);
 
 }   
 
@@ -423,14 +458,10 @@ template<typename Type>
 inline Type* ComponentHandle::GetAs() {
 
     if (HelperFunctions::HashClassName<Type>() == m_ComponentType) {
-        return &Object(m_MasterID).GetComponent<Type>();
+        return Registry().valid(m_MasterID) ? Registry().try_get<Type>(m_MasterID) : nullptr;
     }
 
-    if (auto result = HelperFunctions::CallMetaFunction(m_ComponentType, "Cast To " + HelperFunctions::GetClassName<Type>(), m_MasterID); result) {
-        Type* address = *(Type**)result.data();
-        return address;
-    }
-    return nullptr;
+    return dynamic_cast<Type*>(Get());
 };
 
 template<typename T>
@@ -12,6 +12,10 @@ class ObjectBase {
 protected:
 	virtual void Init() {};
 	virtual void Destroy() {};
+	/**
+	 * Called instead of Init when a pooled object is handed out again.
+	 */
+	virtual void Reset() {};
 
 	friend class ObjectPropertyRegister;
 
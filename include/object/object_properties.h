@@ -1,6 +1,8 @@
 #pragma once
 #include "registry.h"
 #include "object_handle.h"
+#include "../components/component_mask.h"
+#include "hierarchy.h"
 
 
 
@@ -8,20 +10,22 @@
 
 namespace ecspp {
 
+// marks objects that were released to their type's pool, they are skipped when iterating objects
+struct ParkedObject {};
+
+// marks objects queued for deletion, they are hidden the same way until ClearDeletingQueue destroys them
+struct PendingDeletion {};
+
 class Object;
 class ObjectProperties {
 public:
 
-	ObjectProperties(std::string name,entt::id_type masterType,entt::entity e) : m_Name(name), m_Master(e), m_MasterType(masterType)
+	ObjectProperties(std::string name,entt::id_type masterType,entt::entity e) : m_ComponentIndices(GetMemoryResource()), m_MasterType(masterType), m_Children(GetMemoryResource()), m_Name(std::string_view(name), GetMemoryResource()), m_Master(e)
 	{
 	}
 
 	std::string GetName() const {
-		return m_Name;
-	}
-
-	void SetName(std::string name) {
-		m_Name = name;
+		return std::string(m_Name);
 	}
 
 	
@@ -32,9 +36,34 @@ public:
 	}
 
 	void SetParent(ObjectProperties& e) {
-		if (e.m_MasterType == this->m_MasterType) {
-			this->m_Parent = ObjectHandle(e.m_Master.ID());
-			e.AddChildren(*this);
+		if (e.m_MasterType != this->m_MasterType || m_Parent.ID() == e.m_Master.ID()) {
+			return;
+		}
+		for (ObjectProperties* ancestor = &e; ancestor; ancestor = ancestor->m_Parent ? &Registry().get<ObjectProperties>(ancestor->m_Parent.ID()) : nullptr) {
+			if (ancestor == this) {
+				ECSPP_DEBUG_LOG("Could not set parent of object with id " + m_Master.ToString() + " because it would create a cycle!");
+				return;
+			}
+		}
+
+		if (m_Parent) {
+			Registry().get<ObjectProperties>(m_Parent.ID()).RemoveChildren(*this);
+		}
+		this->m_Parent = ObjectHandle(e.m_Master.ID());
+		e.m_Children.push_back(m_Master);
+		Hierarchy::MarkDirty();
+
+		// moving under an object pending deletion dooms the subtree too, so it is hidden before it is destroyed
+		if (Registry().all_of<PendingDeletion>(e.m_Master.ID())) {
+			std::vector<ObjectHandle> subtree = { m_Master };
+			for (size_t next = 0; next < subtree.size(); next++) {
+				Registry().emplace_or_replace<PendingDeletion>(subtree[next].ID());
+				for (auto& child : Registry().get<ObjectProperties>(subtree[next].ID()).m_Children) {
+					if (child) {
+						subtree.push_back(child);
+					}
+				}
+			}
 		}
 	}
 
@@ -42,37 +71,35 @@ public:
 		auto it = std::find(m_Children.begin(), m_Children.end(), e.m_Master);
 		if (it != m_Children.end()) {
 			m_Children.erase(it);
+			e.m_Parent = ObjectHandle();
+			Hierarchy::MarkDirty();
 		}
 	}
 	void AddChildren(ObjectProperties& e) {
-		if (std::find(m_Children.begin(), m_Children.end(), e.m_Master) == m_Children.end() && e.m_MasterType == m_MasterType) {
-			m_Children.push_back(e.m_Master);
-		}
+		e.SetParent(*this);
 	}
-	const std::vector<ObjectHandle>& GetChildren() const {
+	const std::pmr::vector<ObjectHandle>& GetChildren() const {
 		return m_Children;
 	}
 
 
-	const std::vector< std::string>& GetComponentsNames() const {
-		return m_ComponentClassNames;
+	const ComponentIndexList& GetComponentIndices() const {
+		return m_ComponentIndices;
 	}
 
 
 private:
-	void SetComponentsNames(std::vector<std::string> vec) {
-		m_ComponentClassNames = vec;
+	void SetName(std::string name) {
+		m_Name = name;
 	}
 
-	
-
-
-	std::vector<std::string> m_ComponentClassNames;
+	ComponentIndexList m_ComponentIndices;
+	ComponentMask m_ComponentMask;
 
 	entt::id_type m_MasterType;
-	std::vector<ObjectHandle> m_Children;
+	std::pmr::vector<ObjectHandle> m_Children;
 	ObjectHandle m_Parent = ObjectHandle();
-	std::string m_Name;
+	std::pmr::string m_Name;
 	ObjectHandle m_Master;
 
 	friend class ObjectPropertyRegister;
@@ -80,4 +107,64 @@ private:
 	friend class Registry;
 };
 
+inline void Hierarchy::Rebuild(HierarchyState& state) {
+	state.m_Order.clear();
+	state.m_Parent.clear();
+	state.m_SubtreeEnd.clear();
+	state.m_Depth.clear();
+
+	struct Pending {
+		entt::entity m_Entity;
+		entt::entity m_Parent;
+		uint32_t m_Depth;
+	};
+	std::vector<Pending> stack;
+	// positions whose subtree is still open, with strictly increasing depth
+	std::vector<uint32_t> open;
+
+	auto close = [&](uint32_t depth) {
+		while (!open.empty() && state.m_Depth[open.back()] >= depth) {
+			state.m_SubtreeEnd[open.back()] = static_cast<uint32_t>(state.m_Order.size());
+			open.pop_back();
+		}
+	};
+
+	for (auto [root, rootProperties] : Registry().storage<ObjectProperties>().each()) {
+		if (rootProperties.GetParent()) {
+			continue;
+		}
+
+		stack.push_back({ root, entt::null, 0 });
+		while (!stack.empty()) {
+			Pending current = stack.back();
+			stack.pop_back();
+
+			close(current.m_Depth);
+			open.push_back(static_cast<uint32_t>(state.m_Order.size()));
+			state.m_Order.push_back(current.m_Entity);
+			state.m_Parent.push_back(current.m_Parent);
+			state.m_SubtreeEnd.push_back(0);
+			state.m_Depth.push_back(current.m_Depth);
+
+			// pushed in reverse so children come out in the order they were added
+			auto& children = Registry().get<ObjectProperties>(current.m_Entity).GetChildren();
+			for (auto it = children.rbegin(); it != children.rend(); it++) {
+				if (*it) {
+					stack.push_back({ it->ID(), current.m_Entity, current.m_Depth + 1 });
+				}
+			}
+		}
+		close(0);
+	}
+
+	state.m_PositionByIndex.clear();
+	for (uint32_t position = 0; position < state.m_Order.size(); position++) {
+		auto index = entt::to_entity(state.m_Order[position]);
+		if (index >= state.m_PositionByIndex.size()) {
+			state.m_PositionByIndex.resize(index + 1, std::numeric_limits<uint32_t>::max());
+		}
+		state.m_PositionByIndex[index] = position;
+	}
+}
+
 };
\ No newline at end of file
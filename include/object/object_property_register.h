@@ -2,9 +2,22 @@
 
 #include <iostream>
 #include <unordered_map>
+#include <array>
+#include <atomic>
+#include <shared_mutex>
+#include <cctype>
+#include <cmath>
+#include <span>
+#include <algorithm>
+#include <chrono>
+#include <limits>
 #include "../components/component.h"
+#include "../components/component_ticks.h"
+#include "../components/soa_storage.h"
+#include "../components/entity_remap.h"
 #include "registry.h"
 #include "../helpers/helpers.h"
+#include "../helpers/thread_pool.h"
 #include "../../vendor/entt/single_include/entt/entt.hpp"
 #include "object_properties.h"
 #include "object_base.h"
@@ -13,7 +26,54 @@
 
 namespace ecspp {
 
-	
+// plain function pointers filled when a component type is registered, indexed by its dense ComponentIndex
+struct ComponentTypeInfo {
+	std::string m_Name;
+	entt::id_type m_NameHash;
+	entt::id_type m_TypeHash;
+
+	void*(*m_Create)(entt::entity) = nullptr;
+	Component*(*m_CastToBase)(entt::entity) = nullptr;
+	void(*m_Update)(entt::entity, float) = nullptr;
+	void(*m_UpdateBucket)(float, uint32_t, uint32_t) = nullptr;
+	bool(*m_Copy)(entt::entity, entt::entity) = nullptr;
+	bool(*m_Erase)(entt::entity) = nullptr;
+	bool(*m_Has)(entt::entity) = nullptr;
+
+	size_t(*m_CreateRange)(const entt::entity*, const entt::entity*) = nullptr;
+	size_t(*m_EraseRange)(const entt::entity*, const entt::entity*) = nullptr;
+	size_t(*m_Clear)() = nullptr;
+	std::shared_ptr<void>(*m_Capture)(entt::entity) = nullptr;
+	void(*m_CopyToRange)(const void*, const entt::entity*, const entt::entity*) = nullptr;
+	void(*m_CloneRange)(const entt::entity*, const entt::entity*, size_t, const EntityRemap&) = nullptr;
+};
+
+// what each World keeps for a component type, indexed like ComponentTypeInfo
+struct ComponentTypeState {
+	// zero interval means every UpdateAll call, more than one bucket staggers the instances over that many ticks
+	float m_UpdateInterval = 0.0f;
+	uint32_t m_UpdateBuckets = 1;
+
+	float m_UpdateAccumulator = 0.0f;
+	uint32_t m_CurrentUpdateBucket = 0;
+	std::vector<float> m_TimeSinceBucketUpdate;
+
+	// bumped whenever instances of the type may have moved, cached component pointers compare against it
+	uint64_t m_StorageEpoch = 0;
+};
+
+// register state kept per World, the register itself only holds the type registrations shared by every world
+struct RegisterState {
+	std::unordered_multimap<std::string, entt::entity> m_ObjectsByName;
+	std::unordered_map<std::string, int> m_NextNameSuffixByBaseName;
+	// objects named after each base name, "Name" and "Name(3)" both count for "Name"
+	std::unordered_map<std::string, size_t> m_NameCountByBaseName;
+	std::unordered_map<entt::id_type, std::vector<entt::entity>> m_ParkedObjectsByType;
+	std::unordered_map<entt::id_type, std::shared_ptr<void>> m_SoAStorages;
+	// sized for every possible type up front, UpdateAll holds on to an entry while Update may register new types
+	std::vector<ComponentTypeState> m_ComponentTypeStates = std::vector<ComponentTypeState>(ECSPP_MAX_COMPONENT_TYPES);
+	Tick m_CurrentTick = 0;
+};
 
 struct ComponentHandle {
 public:
@@ -22,23 +82,16 @@ public:
 
 	};
 
-	ComponentHandle(entt::entity e,entt::id_type type)
+	ComponentHandle(entt::entity e, entt::id_type type);
+
+	ComponentHandle(entt::entity e, entt::id_type type, ComponentIndex index)
 	{
 		m_MasterID = e;
 		m_ComponentType = type;
-
+		m_ComponentIndex = index;
 	};
 
-	Component* Get() {
-		auto any = HelperFunctions::CallMetaFunction(m_ComponentType,"Cast To Base",m_MasterID);
-
-		if (!any) {
-			ECSPP_DEBUG_LOG("Calling Get() without valid master id or component id");
-			return nullptr;
-		}
-
-		return *(Component**)any.data();
-	};
+	Component* Get();
 
 	template<typename Type>
 	Type* GetAs();
@@ -52,13 +105,12 @@ public:
 		return m_ComponentType == HelperFunctions::HashClassName<T>();
 	};
 
-	operator bool() {
-		return Registry().valid(m_MasterID) && (Registry().storage(HelperFunctions::GetClassHash(m_ComponentType)) != Registry().storage().end());
-	};
+	operator bool();
 
 private:
 	entt::entity m_MasterID = entt::null;
 	entt::id_type m_ComponentType = entt::null;
+	ComponentIndex m_ComponentIndex = NullComponentIndex;
 
 };
 
@@ -82,8 +134,8 @@ public:
 
 	template<typename Storage, typename MainClass>
 	static void RegisterClassAsPropertyStorage() {
-		m_PropertyStorageContainer[HelperFunctions::HashClassName<MainClass>()] = [](entt::entity e) {
-			Registry().emplace<Storage>(e);
+		m_PropertyStorageContainer[HelperFunctions::HashClassName<MainClass>()] = [](const entt::entity* first, const entt::entity* last) {
+			Registry().insert<Storage>(first, last);
 		};
 	};
 
@@ -99,9 +151,11 @@ public:
 		entt::meta<Attached>().type(hash).template func<&ObjectPropertyRegister::ForEachByTag<Tag, Attached>>(entt::hashed_string("ForEach"));
 		entt::meta<Attached>().type(hash).template func<&ObjectPropertyRegister::CreateObjectAndReturnHandle<Attached>>(entt::hashed_string("Create"));
 		entt::meta<Attached>().type(hash).template func<&ObjectPropertyRegister::CallDestroyForObject<Attached>>(entt::hashed_string("Destroy"));
+		m_ObjectDestroyersByType[hash] = &ObjectPropertyRegister::CallDestroyForObject<Attached>;
+		m_ObjectCreatorsByType[hash] = &ObjectPropertyRegister::CreateObjects<Attached>;
 		entt::meta<Attached>().type(hash).template func<& ObjectPropertyRegister::CallVirtualFunc<Attached>>(entt::hashed_string("CallVirtualFunc"));
-		m_RegisteredObjectTagsStartingFuncs[hash] = [](entt::entity e) {
-			Registry().emplace<Tag>(e);
+		m_RegisteredObjectTagsStartingFuncs[hash] = [](const entt::entity* first, const entt::entity* last) {
+			Registry().insert<Tag>(first, last);
 		};
 		m_RegisteredTypesByTag[entt::type_hash<Tag>().value()] = hash;
 		m_RegisteredTagsByType[hash] = entt::type_hash<Tag>().value();
@@ -141,11 +195,11 @@ public:
 
 
 		if (m_RegisteredObjectTagsStartingFuncs.find(hash) != m_RegisteredObjectTagsStartingFuncs.end()) {
-			m_RegisteredObjectTagsStartingFuncs[hash](ent);
+			m_RegisteredObjectTagsStartingFuncs[hash](&ent, &ent + 1);
 		}
 
 		if (m_PropertyStorageContainer.find(hash) != m_PropertyStorageContainer.end()) {
-			m_PropertyStorageContainer[hash](ent);
+			m_PropertyStorageContainer[hash](&ent, &ent + 1);
 		}
 
 		T obj(ent, args...);
@@ -170,51 +224,87 @@ public:
 
 	template<typename T>
 	static T CopyObject(T other) {
-		entt::entity firstObject = entt::null;
-		entt::entity lastObject = entt::null;
+		return T(CloneSubtree(other.ID()));
+	};
 
-		other.ForSelfAndEachChild([&](T current) {
-			T newOne = DuplicateObject<T>(current);
-			if (firstObject == entt::null) {
-				firstObject = newOne.ID();
-			}
-			if (lastObject != entt::null) {
-				newOne.SetParent(T(lastObject));
+	/**
+	 * Clones root and its subtree, returns the clone of root.
+	 */
+	static entt::entity CloneSubtree(entt::entity root) {
+		if (!Registry().valid(root)) {
+			ECSPP_DEBUG_LOG("Could not copy object with id " + std::to_string((uint32_t)root) + " because it was not valid!");
+			return entt::null;
+		}
+
+		// plain objects have no tag and so no registered creator
+		auto creator = m_ObjectCreatorsByType.find(Registry().get<ObjectProperties>(root).m_MasterType);
+		auto create = creator != m_ObjectCreatorsByType.end() ? creator->second : &ObjectPropertyRegister::CreateObjects<Object>;
+
+		// breadth first, remembering the position of each parent
+		std::vector<entt::entity> sources = { root };
+		std::vector<uint32_t> parents = { 0 };
+		for (uint32_t next = 0; next < sources.size(); next++) {
+			for (auto& child : Registry().get<ObjectProperties>(sources[next]).GetChildren()) {
+				if (child && !Registry().all_of<PendingDeletion>(child.ID())) {
+					sources.push_back(child.ID());
+					parents.push_back(next);
+				}
 			}
-			lastObject = newOne.ID();
-			});
-		return T(firstObject);
-	};
+		}
+
+		std::vector<std::string> names;
+		names.reserve(sources.size());
+		for (auto e : sources) {
+			names.push_back(Registry().get<ObjectProperties>(e).GetName());
+		}
+
+		std::vector<entt::entity> clones(sources.size());
+		create(names, clones.data());
+
+		for (size_t i = 1; i < clones.size(); i++) {
+			ObjectProperties& clone = Registry().get<ObjectProperties>(clones[i]);
+			clone.m_Parent = ObjectHandle(clones[parents[i]]);
+			Registry().get<ObjectProperties>(clones[parents[i]]).m_Children.push_back(ObjectHandle(clones[i]));
+		}
+		Hierarchy::MarkDirty();
+
+		CloneComponentsOfSubtree(sources, clones);
+
+		return clones[0];
+	}
 
 	static ObjectHandle FindObjectByName(std::string name) {
-		for (auto [handle, comp] : Registry().storage<ObjectProperties>().each()) {
-			if (comp.GetName() == name) {
-				return ObjectHandle(handle);
+		auto [begin, end] = State().m_ObjectsByName.equal_range(name);
+		for (auto it = begin; it != end; it++) {
+			if (Registry().valid(it->second)) {
+				return ObjectHandle(it->second);
 			}
 		}
 		return ObjectHandle();
 
 	};
 
+	static void SetObjectName(entt::entity e, std::string name) {
+		if (!Registry().valid(e)) {
+			return;
+		}
+		ObjectProperties& properties = Registry().get<ObjectProperties>(e);
+
+		UnindexObjectName(e, properties.GetName());
+		properties.SetName(name);
+		IndexObjectName(e, name);
+	}
+
 	template<typename T, typename... Args>
 	static T CreateNew(std::string name, Args&&... args) {
 		static_assert(std::is_base_of<Object, T>::value);
 
 		entt::entity ent = Registry().create();
 
-		int index = 1;
-		if (FindObjectByName(name)) {
-			if (name.find_last_of(")") == std::string::npos || (name.find_last_of(")") != name.size() - 1)) {
-				name += "(" + std::to_string(index) + ")";
-			}
-		}
-
-		while (FindObjectByName(name)) {
-			index++;
-			name.replace(name.find_last_of("(") + 1, std::to_string(index - 1).size(), std::to_string(index));
-		}
+		name = MakeUniqueName(name);
 
 		Registry().emplace<ObjectProperties>(ent, name, HelperFunctions::HashClassName<T>(), ent);
+		IndexObjectName(ent, name);
 
 		ObjectPropertyRegister::InitializeObject<T, Args...>(ent, args...);
 
@@ -224,6 +314,65 @@ public:
 
 
 
+	template<typename T>
+	static std::vector<T> CreateMany(size_t count, std::string baseName) {
+		return CreateMany<T>(std::vector<std::string>(count, baseName));
+	}
+
+	/**
+	 * Creates one object per name in a single batch.
+	 */
+	template<typename T>
+	static std::vector<T> CreateMany(const std::vector<std::string>& baseNames) {
+		static_assert(std::is_base_of<Object, T>::value);
+
+		size_t count = baseNames.size();
+		std::vector<entt::entity> entities(count);
+		Registry().create(entities.begin(), entities.end());
+
+		entt::id_type hash = HelperFunctions::HashClassName<T>();
+
+		std::vector<ObjectProperties> properties;
+		properties.reserve(count);
+		for (size_t i = 0; i < count; i++) {
+			std::string name = MakeUniqueName(baseNames[i]);
+			IndexObjectName(entities[i], name);
+			properties.emplace_back(name, hash, entities[i]);
+		}
+		// moving keeps the memory resource of the names and children lists
+		Registry().insert<ObjectProperties>(entities.begin(), entities.end(), std::make_move_iterator(properties.begin()));
+
+		const entt::entity* first = entities.data();
+		const entt::entity* last = entities.data() + entities.size();
+
+		if (m_RegisteredObjectTagsStartingFuncs.find(hash) != m_RegisteredObjectTagsStartingFuncs.end()) {
+			m_RegisteredObjectTagsStartingFuncs[hash](first, last);
+		}
+
+		if (m_PropertyStorageContainer.find(hash) != m_PropertyStorageContainer.end()) {
+			m_PropertyStorageContainer[hash](first, last);
+		}
+
+		std::vector<T> objects;
+		objects.reserve(count);
+		for (auto e : entities) {
+			T& obj = objects.emplace_back(e);
+			((ObjectBase*)(&obj))->Init();
+		}
+
+		if (m_ComponentsToMakeAvailableAtStartByType.find(hash) != m_ComponentsToMakeAvailableAtStartByType.end()) {
+			for (auto& componentName : m_ComponentsToMakeAvailableAtStartByType[hash]) {
+				AddComponentToRangeByName(first, last, componentName);
+			}
+		}
+
+		for (auto& componentName : m_ComponentsToMakeOmnipresent) {
+			AddComponentToRangeByName(first, last, componentName);
+		}
+
+		return objects;
+	}
+
 	template<typename Component, typename ComponentType>
 	static void RegisterClassAsComponentOfType() {
 		m_RegisteredComponentsByType[m_RegisteredComponentByObjectType[HelperFunctions::HashClassName<ComponentType>()]].push_back(HelperFunctions::GetClassName<Component>());
@@ -232,27 +381,60 @@ public:
 		m_RegisteredComponentsNames[entt::type_hash<Component>().value()] = HelperFunctions::GetClassName<Component>();
 	};
 
+	template<typename Component>
+	static void RegisterClassAsSoAComponent() {
+		GetComponentIndex<Component>();
+		m_RegisteredComponentsNames[entt::type_hash<Component>().value()] = HelperFunctions::GetClassName<Component>();
+	};
+
+	template<typename Component>
+	static void RegisterClassAsPodComponent() {
+		RegisterClassAsComponent<Component>();
+		m_RegisteredComponentsNames[entt::type_hash<Component>().value()] = HelperFunctions::GetClassName<Component>();
+	};
+
 	static std::vector<std::string> GetObjectComponents(entt::entity e) {
 		std::vector<std::string> vec;
-		for (auto [id, storage] : Registry().storage()) {
-			if (id == entt::type_hash<ObjectProperties>().value()) {
-				continue;
-			}
-
-			std::string objectType = GetObjectType(e);
+		if (!Registry().valid(e) || !Registry().all_of<ObjectProperties>(e)) {
+			return vec;
+		}
 
-			entt::id_type objectHash = entt::hashed_string(objectType.c_str());
-			if (std::find(m_RegisteredComponentsByType[entt::hashed_string(objectType.c_str())].begin(), m_RegisteredComponentsByType[entt::hashed_string(objectType.c_str())].end(), ObjectPropertyRegister::GetComponentNameByID(id)) == m_RegisteredComponentsByType[entt::hashed_string(objectType.c_str())].end()) {
-				continue;
-			}
-			if (storage.contains(e)) {
-				vec.push_back(GetComponentNameByID(id));
-			}
+		const ComponentIndexList& indices = Registry().get<ObjectProperties>(e).m_ComponentIndices;
+		vec.reserve(indices.size());
+		for (auto index : indices) {
+			vec.push_back(m_ComponentTypes[index].m_Name);
 		}
 		return vec;
 
 	}
 
+	template<typename T>
+	static ComponentIndex GetComponentIndex() {
+		static const ComponentIndex index = RegisterComponentType<T>();
+		return index;
+	}
+
+	static ComponentIndex GetComponentIndexByName(const std::string& name) {
+		return GetComponentIndexByHash(entt::hashed_string(name.c_str()));
+	}
+
+	static ComponentIndex GetComponentIndexByHash(entt::id_type nameHash) {
+		std::shared_lock<std::shared_mutex> lock(m_ComponentTypesMutex);
+		auto it = m_ComponentIndexByNameHash.find(nameHash);
+		if (it != m_ComponentIndexByNameHash.end()) {
+			return it->second;
+		}
+		return NullComponentIndex;
+	}
+
+	static const ComponentTypeInfo& GetComponentTypeInfo(ComponentIndex index) {
+		return m_ComponentTypes[index];
+	}
+
+	static size_t GetNumberOfComponentTypes() {
+		return m_ComponentTypeCount.load(std::memory_order_acquire);
+	}
+
 	static std::string GetClassNameByID(entt::id_type id) {
 		if (m_RegisteredObjectNames.find(id) != m_RegisteredObjectNames.end()) {
 			return m_RegisteredObjectNames[id];
@@ -269,7 +451,7 @@ public:
 
 	static void Each(std::function<void(ObjectHandle)> func) {
 		Registry().each([&](entt::entity e) {
-			if (ObjectHandle(e)) {
+			if (ObjectHandle(e) && !Registry().any_of<ParkedObject, PendingDeletion>(e)) {
 				func(ObjectHandle(e));
 			}
 			});
@@ -277,52 +459,381 @@ public:
 
 	static bool DeleteObject(ObjectHandle obj) {
 		if (obj) {
-			m_ObjectsToDelete.push_back(obj);
+			if (Registry().all_of<PendingDeletion>(obj.ID())) {
+				return true;
+			}
+			// the marker is the queue, the subtree is hidden right away even if it is only destroyed over several frames
+			std::vector<ObjectHandle> objectAndAllChildren;
+			GetAllChildren(obj, objectAndAllChildren);
+			for (auto& handle : objectAndAllChildren) {
+				Registry().emplace_or_replace<PendingDeletion>(handle.ID());
+			}
 			return true;
 		}
 		ECSPP_DEBUG_LOG("Could not delete object with id " + obj.ToString() + " because it was not valid!");
 		return false;
 	}
 
+	/**
+	 * Destroys every object marked for deletion, only the deleted objects and the storages they use are touched.
+	 */
 	static void ClearDeletingQueue() {
-		for (auto& objHandle : m_ObjectsToDelete) {
-			if (!objHandle) {
+		ClearDeletingQueue(std::numeric_limits<size_t>::max());
+	}
+
+	/**
+	 * Destroys up to maxObjects of the marked objects within maxTime, returns true once none are left.
+	 */
+	static bool ClearDeletingQueue(size_t maxObjects, std::chrono::nanoseconds maxTime = std::chrono::nanoseconds::max()) {
+		// without a time limit everything fits in one batch, otherwise the clock is checked between batches
+		constexpr size_t timedBatchSize = 1024;
+		bool timed = maxTime != std::chrono::nanoseconds::max();
+		auto start = std::chrono::steady_clock::now();
+
+		auto& pending = Registry().storage<PendingDeletion>();
+		std::vector<entt::entity> doomed;
+		size_t destroyed = 0;
+
+		while (!pending.empty() && destroyed < maxObjects) {
+			size_t batchSize = std::min(pending.size(), maxObjects - destroyed);
+			if (timed) {
+				batchSize = std::min(batchSize, timedBatchSize);
+			}
+
+			// taken from the back, destroying them pops the marker storage without moving the rest
+			doomed.assign(pending.data() + pending.size() - batchSize, pending.data() + pending.size());
+			std::sort(doomed.begin(), doomed.end());
+
+			DestroyObjects(doomed);
+			destroyed += doomed.size();
+
+			if (timed && std::chrono::steady_clock::now() - start >= maxTime) {
+				break;
+			}
+		}
+
+		return pending.empty();
+	}
+
+	/**
+	 * Destroys the given objects and their children right away, the rest of the deleting queue is left alone.
+	 */
+	static void DestroySubtrees(std::span<const entt::entity> roots) {
+		std::vector<ObjectHandle> handles;
+		for (auto e : roots) {
+			GetAllChildren(ObjectHandle(e), handles);
+		}
+
+		std::vector<entt::entity> doomed;
+		doomed.reserve(handles.size());
+		for (auto& handle : handles) {
+			if (handle) {
+				doomed.push_back(handle.ID());
+			}
+		}
+		// a root may also be listed below one of the others
+		std::sort(doomed.begin(), doomed.end());
+		doomed.erase(std::unique(doomed.begin(), doomed.end()), doomed.end());
 
+		DestroyObjects(doomed);
+	}
+
+	template<typename T>
+	static T AcquireFromPool(std::string name) {
+		auto& pool = State().m_ParkedObjectsByType[HelperFunctions::HashClassName<T>()];
+
+		while (pool.size() > 0) {
+			entt::entity e = pool.back();
+			pool.pop_back();
+
+			// parked objects marked for deletion are destroyed by the next ClearDeletingQueue, they only leave the pool
+			if (!Registry().valid(e) || !Registry().all_of<ParkedObject>(e) || Registry().all_of<PendingDeletion>(e)) {
 				continue;
 			}
-			std::vector<ObjectHandle> objectAndAllChildren;
 
-			GetAllChildren(objHandle, objectAndAllChildren);
+			Registry().remove<ParkedObject>(e);
 
-			for (auto& objectHandle : objectAndAllChildren) {
-				if (!objectHandle) {
-					ECSPP_DEBUG_LOG("Could not delete object with id " + objectHandle.ToString() + " because it was not valid! During ObjectPropertyRegister::ClearDeletingQueue()");
-					continue;
-				}
-				std::string objectType = GetObjectType(objectHandle.ID());
+			name = MakeUniqueName(name);
+			Registry().get<ObjectProperties>(e).SetName(name);
+			IndexObjectName(e, name);
 
-				if (objectType == "") {
-					continue;
-				}
+			T obj(e);
+			((ObjectBase*)(&obj))->Reset();
 
-				std::vector<std::string> componentNames = GetObjectComponents(objectHandle.ID());
-				auto it = componentNames.begin();
-				while (it != componentNames.end()) {
-					HelperFunctions::CallMetaFunction(*it, "Erase Component", objectHandle.ID());
-					it++;
-				}
+			return obj;
+		}
+
+		return CreateNew<T>(name);
+	}
+
+	static bool ReleaseToPool(ObjectHandle obj) {
+		if (!obj || Registry().any_of<ParkedObject, PendingDeletion>(obj.ID())) {
+			ECSPP_DEBUG_LOG("Could not release object with id " + obj.ToString() + " to its pool because it was not valid or is being deleted!");
+			return false;
+		}
+
+		std::vector<ObjectHandle> objectAndAllChildren;
+
+		GetAllChildren(obj, objectAndAllChildren);
+
+		ObjectProperties& properties = Registry().get<ObjectProperties>(obj.ID());
+		if (properties.m_Parent) {
+			Registry().get<ObjectProperties>(properties.m_Parent.ID()).RemoveChildren(properties);
+		}
+
+		for (auto& handle : objectAndAllChildren) {
+			ObjectProperties& current = Registry().get<ObjectProperties>(handle.ID());
+
+			current.m_Parent = ObjectHandle();
+			current.m_Children.clear();
+			Hierarchy::MarkDirty();
+
+			UnindexObjectName(handle.ID(), current.GetName());
+			Registry().emplace<ParkedObject>(handle.ID());
+			State().m_ParkedObjectsByType[current.m_MasterType].push_back(handle.ID());
+		}
+
+		return true;
+	}
+
+	template<typename T>
+	static size_t GetNumberOfPooledObjects() {
+		return State().m_ParkedObjectsByType[HelperFunctions::HashClassName<T>()].size();
+	}
+
+	template<typename T>
+	static void ClearPool() {
+		auto& pool = State().m_ParkedObjectsByType[HelperFunctions::HashClassName<T>()];
+		for (auto e : pool) {
+			if (Registry().valid(e)) {
+				DeleteObject(ObjectHandle(e));
+			}
+		}
+		pool.clear();
+	}
+
+	/**
+	 * Updates every component of every registered type, walking each storage contiguously.
+	 */
+	static void UpdateAll(float deltaTime) {
+		for (size_t index = 0; index < m_ComponentTypeCount.load(std::memory_order_acquire); index++) {
+			ComponentTypeInfo& info = m_ComponentTypes[index];
+
+			if (info.m_UpdateBucket == nullptr) {
+				continue;
+			}
 
-				if (!HelperFunctions::CallMetaFunction(objectType, "Destroy", objectHandle.ID())) {
-					ECSPP_DEBUG_LOG("Could not call destroy for object with type: " + objectType);
+			ComponentTypeState& state = TypeState(static_cast<ComponentIndex>(index));
+
+			if (state.m_UpdateInterval <= 0.0f) {
+				TickComponentType(info, state, deltaTime);
+				continue;
+			}
+
+			state.m_UpdateAccumulator += deltaTime;
+
+			int steps = 0;
+			while (state.m_UpdateAccumulator >= state.m_UpdateInterval) {
+				if (steps == ECSPP_MAX_FIXED_UPDATE_STEPS) {
+					// dropping the backlog instead of falling further behind every frame
+					state.m_UpdateAccumulator = std::fmod(state.m_UpdateAccumulator, state.m_UpdateInterval);
+					break;
 				}
-				Registry().destroy(objectHandle.ID());
+				TickComponentType(info, state, state.m_UpdateInterval);
+				state.m_UpdateAccumulator -= state.m_UpdateInterval;
+				steps++;
 			}
+		}
+	}
 
+	/**
+	 * Fixed timestep of 1 / updatesPerSecond for T in the current world, zero updates on every call.
+	 */
+	template<typename T>
+	static void SetComponentUpdateRate(float updatesPerSecond) {
+		ComponentTypeState& state = TypeState(GetComponentIndex<T>());
+		state.m_UpdateInterval = updatesPerSecond > 0.0f ? 1.0f / updatesPerSecond : 0.0f;
+		state.m_UpdateAccumulator = 0.0f;
+	}
+
+	/**
+	 * Updates one of bucketCount buckets of T per tick in the current world.
+	 */
+	template<typename T>
+	static void SetComponentUpdateStagger(uint32_t bucketCount) {
+		ComponentTypeState& state = TypeState(GetComponentIndex<T>());
+		state.m_UpdateBuckets = bucketCount > 0 ? bucketCount : 1;
+		state.m_CurrentUpdateBucket = 0;
+		state.m_TimeSinceBucketUpdate.assign(state.m_UpdateBuckets, 0.0f);
+	}
+
+	/**
+	 * Adds T, constructed from args, to every valid entity in the range that doesn't have it yet.
+	 */
+	template<typename T, typename... Args>
+	static size_t AddComponentToAll(std::span<const entt::entity> entities, const Args&... args) {
+		auto& storage = Registry().storage<T>();
+		auto& ticks = Registry().storage<ComponentTicks<T>>();
+		storage.reserve(storage.size() + entities.size());
+		ticks.reserve(ticks.size() + entities.size());
+
+		ComponentIndex index = GetComponentIndex<T>();
+		size_t added = 0;
+		for (auto e : entities) {
+			if (!Registry().valid(e) || storage.contains(e)) {
+				continue;
+			}
+			T& comp = storage.emplace(e, args...);
+			if constexpr (IsVirtualComponent<T>) {
+				static_cast<Component&>(comp).SetMaster(e);
+			}
+			SetComponentPresent(e, index, true);
+			ticks.emplace(e, State().m_CurrentTick, State().m_CurrentTick);
+			if constexpr (IsVirtualComponent<T>) {
+				static_cast<Component&>(comp).Init();
+			}
+			added++;
 		}
-		if (m_ObjectsToDelete.size() > 0) {
-			ValidateAllGameObjects();
+
+		if constexpr (!entt::component_traits<T>::in_place_delete) {
+			BumpStorageEpoch<T>();
 		}
-		m_ObjectsToDelete.clear();
+		return added;
+	}
+
+	/**
+	 * Erases T from every entity in the range that has it, returns how many were erased.
+	 */
+	template<typename T>
+	static size_t EraseComponentFromAll(std::span<const entt::entity> entities) {
+		auto& storage = Registry().storage<T>();
+
+		std::vector<entt::entity> erasing;
+		erasing.reserve(entities.size());
+		for (auto e : entities) {
+			if (storage.contains(e)) {
+				erasing.push_back(e);
+			}
+		}
+		// the same entity may be listed twice, it must be destroyed and erased only once
+		std::sort(erasing.begin(), erasing.end());
+		erasing.erase(std::unique(erasing.begin(), erasing.end()), erasing.end());
+
+		ComponentIndex index = GetComponentIndex<T>();
+		for (auto e : erasing) {
+			if constexpr (IsVirtualComponent<T>) {
+				static_cast<Component&>(storage.get(e)).Destroy();
+			}
+			SetComponentPresent(e, index, false);
+		}
+
+		EraseInstances<T>(erasing);
+		Registry().storage<ComponentTicks<T>>().remove(erasing.begin(), erasing.end());
+		BumpStorageEpoch<T>();
+		return erasing.size();
+	}
+
+	/**
+	 * Erases every instance of T, returns how many were erased.
+	 */
+	template<typename T>
+	static size_t ClearComponent() {
+		auto& storage = Registry().storage<T>();
+
+		ComponentIndex index = GetComponentIndex<T>();
+		size_t count = 0;
+		for (auto e : storage) {
+			if (!storage.contains(e)) {
+				// tombstone left by a pointer stable type
+				continue;
+			}
+			if constexpr (IsVirtualComponent<T>) {
+				static_cast<Component&>(storage.get(e)).Destroy();
+			}
+			SetComponentPresent(e, index, false);
+			count++;
+		}
+
+		storage.clear();
+		Registry().storage<ComponentTicks<T>>().clear();
+		BumpStorageEpoch<T>();
+		return count;
+	}
+
+	static size_t AddComponentToAllByName(std::span<const entt::entity> entities, const std::string& componentName) {
+		ComponentIndex index = GetComponentIndexByName(componentName);
+		if (index == NullComponentIndex) {
+			ECSPP_DEBUG_LOG("Could not construct component of type " + componentName + ", make sure it is derived from DefineComponent");
+			return 0;
+		}
+
+		return m_ComponentTypes[index].m_CreateRange(entities.data(), entities.data() + entities.size());
+	}
+
+	static size_t EraseComponentFromAllByName(std::span<const entt::entity> entities, const std::string& componentName) {
+		ComponentIndex index = GetComponentIndexByName(componentName);
+		if (index == NullComponentIndex) {
+			return 0;
+		}
+		return m_ComponentTypes[index].m_EraseRange(entities.data(), entities.data() + entities.size());
+	}
+
+	static size_t ClearComponentByName(const std::string& componentName) {
+		ComponentIndex index = GetComponentIndexByName(componentName);
+		if (index == NullComponentIndex) {
+			return 0;
+		}
+		return m_ComponentTypes[index].m_Clear();
+	}
+
+	/**
+	 * Tick stamped on components when they are added or written.
+	 */
+	static Tick CurrentTick() {
+		return State().m_CurrentTick;
+	}
+
+	/**
+	 * Starts a new tick and returns it, every write from now on compares greater or equal to it.
+	 */
+	static Tick AdvanceTick() {
+		return ++State().m_CurrentTick;
+	}
+
+	/**
+	 * Calls combine(const T& parent, T& child) down every subtree whose T changed since, returns how many were combined.
+	 */
+	template<typename T, typename Func>
+	static size_t PropagateDown(Func&& combine, Tick since) {
+		static_assert(!IsSoAComponent<T>, "Structure of arrays components can't be propagated!");
+
+		auto& storage = Registry().storage<T>();
+
+		std::vector<entt::entity> dirty;
+		for (auto [e, ticks] : Registry().storage<ComponentTicks<T>>().each()) {
+			if (ticks.m_Changed >= since) {
+				dirty.push_back(e);
+			}
+		}
+
+		size_t combined = 0;
+		Hierarchy::ForEachInSubtrees(dirty, [&](entt::entity e, entt::entity parent) {
+			if (parent == entt::null || !storage.contains(e) || !storage.contains(parent)) {
+				return;
+			}
+			if (Registry().any_of<ParkedObject, PendingDeletion>(e)) {
+				return;
+			}
+			combine(std::as_const(storage.get(parent)), storage.get(e));
+			MarkComponentChanged<T>(e);
+			combined++;
+		});
+		return combined;
+	}
+
+	template<typename T>
+	static uint64_t GetStorageEpoch() {
+		return TypeState(GetComponentIndex<T>()).m_StorageEpoch;
 	}
 
 	static bool IsClassRegistered(std::string className) {
@@ -344,6 +855,22 @@ protected:
 	}
 
 
+	static void SetComponentPresent(entt::entity e, ComponentIndex index, bool present) {
+		ObjectProperties* properties = Registry().try_get<ObjectProperties>(e);
+		if (!properties || properties->m_ComponentMask.Test(index) == present) {
+			return;
+		}
+
+		if (present) {
+			properties->m_ComponentMask.Set(index);
+			properties->m_ComponentIndices.push_back(index);
+		}
+		else {
+			properties->m_ComponentMask.Reset(index);
+			properties->m_ComponentIndices.erase(index);
+		}
+	}
+
 	static bool IsHandleValid(entt::entity e) {
 		if (Registry().valid(e)) {
 			return true;
@@ -352,6 +879,23 @@ protected:
 
 	}
 
+	template<typename T>
+	static void BumpStorageEpoch() {
+		TypeState(GetComponentIndex<T>()).m_StorageEpoch++;
+	}
+
+	template<typename T>
+	static void MarkComponentAdded(entt::entity e) {
+		Registry().emplace_or_replace<ComponentTicks<T>>(e, State().m_CurrentTick, State().m_CurrentTick);
+	}
+
+	template<typename T>
+	static void MarkComponentChanged(entt::entity e) {
+		if (ComponentTicks<T>* ticks = Registry().try_get<ComponentTicks<T>>(e)) {
+			ticks->m_Changed = State().m_CurrentTick;
+		}
+	}
+
 	template<typename T>
 	static bool HasComponent(entt::entity e) {
 		
@@ -362,8 +906,6 @@ protected:
 		return Registry().all_of<T>(e);
 	};
 
-	static void RegisterComponentsNames(entt::entity e);
-
 	template<typename T, typename... Args>
 	static T* AddComponent(entt::entity e, Args&&... args) {
 
@@ -376,11 +918,19 @@ protected:
 			return &Registry().get<T>(e);
 		}
 
-		Component* comp = (Component*)&Registry().emplace<T>(e, std::forward<Args>(args)...);
-		comp->SetMaster(e);
-		comp->Init();
-
-		RegisterComponentsNames(e);
+		T& comp = Registry().emplace<T>(e, std::forward<Args>(args)...);
+		if constexpr (IsVirtualComponent<T>) {
+			static_cast<Component&>(comp).SetMaster(e);
+		}
+		SetComponentPresent(e, GetComponentIndex<T>(), true);
+		MarkComponentAdded<T>(e);
+		if constexpr (!entt::component_traits<T>::in_place_delete) {
+			// owning groups swap instances around when one is added
+			BumpStorageEpoch<T>();
+		}
+		if constexpr (IsVirtualComponent<T>) {
+			static_cast<Component&>(comp).Init();
+		}
 
 		return &Registry().get<T>(e);;
 		
@@ -428,21 +978,18 @@ protected:
 			return {};
 		}
 
-		auto resolved = entt::resolve(entt::hashed_string(stringToHash.c_str()));
-		void* returnData = nullptr;
-		if (resolved) {
-			if (auto func = resolved.func(entt::hashed_string("Create Component")); func) {
-
-				entt::meta_any owner = func.invoke({}, e);
-				returnData = owner.data();
+		ComponentIndex index = GetComponentIndexByName(stringToHash);
+		if (index == NullComponentIndex) {
+			ECSPP_DEBUG_LOG("Could not construct component of type " + stringToHash + ", make sure it is derived from DefineComponent");
+			return ComponentHandle(e, entt::hashed_string(stringToHash.c_str()));
+		}
 
-				if (owner.data() == nullptr) {
-					ECSPP_DEBUG_LOG("Could not construct component of type " + stringToHash);
-				}
-			}
+		const ComponentTypeInfo& info = m_ComponentTypes[index];
+		if (info.m_Create(e) == nullptr) {
+			ECSPP_DEBUG_LOG("Could not construct component of type " + stringToHash);
 		}
 
-		return ComponentHandle(e, entt::hashed_string(stringToHash.c_str()));
+		return ComponentHandle(e, info.m_NameHash, index);
 
 	};
 
@@ -454,20 +1001,152 @@ protected:
 	template<typename T>
 	static bool EraseComponent(entt::entity e) {
 		if (HasComponent<T>(e)) {
-			dynamic_cast<Component*>(GetComponent<T>(e))->Destroy();
+			if constexpr (IsVirtualComponent<T>) {
+				static_cast<Component&>(Registry().get<T>(e)).Destroy();
+			}
 
-			Registry().storage<T>().erase(e);
+			EraseInstances<T>(std::span<const entt::entity>(&e, 1));
+			Registry().remove<ComponentTicks<T>>(e);
+			BumpStorageEpoch<T>();
+			SetComponentPresent(e, GetComponentIndex<T>(), false);
 			return true;
 		}
 		return false;
 	}
 
+	// erasing moves the last instance into the freed slot, assignment keeps the master of the slot so it is set again
+	template<typename T>
+	static void EraseInstances(std::span<const entt::entity> erasing) {
+		auto& storage = Registry().storage<T>();
+		if constexpr (IsVirtualComponent<T> && !entt::component_traits<T>::in_place_delete) {
+			std::vector<size_t> slots;
+			slots.reserve(erasing.size());
+			for (auto e : erasing) {
+				slots.push_back(storage.index(e));
+			}
+			storage.erase(erasing.begin(), erasing.end());
+			for (auto slot : slots) {
+				if (slot < storage.size()) {
+					static_cast<Component&>(storage.get(storage.data()[slot])).SetMaster(storage.data()[slot]);
+				}
+			}
+		}
+		else {
+			storage.erase(erasing.begin(), erasing.end());
+		}
+	}
+
+	template<typename T>
+	static SoAStorage<T>& GetSoAStorage() {
+		auto& storages = State().m_SoAStorages;
+		// only looking up existing storages keeps this safe for the parallel copies of CloneSubtree
+		if (auto it = storages.find(entt::type_hash<T>().value()); it != storages.end() && it->second) {
+			return *static_cast<SoAStorage<T>*>(it->second.get());
+		}
+		std::shared_ptr<void>& storage = storages[entt::type_hash<T>().value()];
+		storage = std::make_shared<SoAStorage<T>>();
+		return *static_cast<SoAStorage<T>*>(storage.get());
+	}
+
+	template<typename T>
+	static bool HasSoAComponent(entt::entity e) {
+		return GetSoAStorage<T>().Contains(e);
+	}
+
+	template<typename T>
+	static SoARef<T> AddSoAComponent(entt::entity e, const T& value = T{}) {
+		SoAStorage<T>& storage = GetSoAStorage<T>();
+		if (IsHandleValid(e) && !storage.Contains(e)) {
+			storage.Emplace(e, value);
+			SetComponentPresent(e, GetComponentIndex<T>(), true);
+		}
+		return SoARef<T>(&storage, e);
+	}
+
+	template<typename T>
+	static bool EraseSoAComponent(entt::entity e) {
+		SoAStorage<T>& storage = GetSoAStorage<T>();
+		if (!storage.Contains(e)) {
+			return false;
+		}
+		storage.Erase(e);
+		SetComponentPresent(e, GetComponentIndex<T>(), false);
+		return true;
+	}
+
+	template<typename T>
+	static bool CopySoAComponent(entt::entity first, entt::entity second) {
+		SoAStorage<T>& storage = GetSoAStorage<T>();
+		if (!storage.Contains(first) || !storage.Contains(second)) {
+			return false;
+		}
+		storage.Store(storage.Row(second), storage.Load(storage.Row(first)));
+		return true;
+	}
+
+	template<typename T>
+	static size_t CreateSoAComponents(const entt::entity* first, const entt::entity* last) {
+		SoAStorage<T>& storage = GetSoAStorage<T>();
+		storage.Reserve(storage.Size() + (last - first));
+
+		ComponentIndex index = GetComponentIndex<T>();
+		size_t added = 0;
+		for (auto it = first; it != last; it++) {
+			if (!Registry().valid(*it) || storage.Contains(*it)) {
+				continue;
+			}
+			storage.Emplace(*it, T{});
+			SetComponentPresent(*it, index, true);
+			added++;
+		}
+		return added;
+	}
+
+	template<typename T>
+	static size_t EraseSoAComponents(const entt::entity* first, const entt::entity* last) {
+		size_t erased = 0;
+		for (auto it = first; it != last; it++) {
+			erased += EraseSoAComponent<T>(*it);
+		}
+		return erased;
+	}
+
+	template<typename T>
+	static size_t ClearSoAComponent() {
+		SoAStorage<T>& storage = GetSoAStorage<T>();
+		ComponentIndex index = GetComponentIndex<T>();
+		for (auto e : storage.Entities()) {
+			SetComponentPresent(e, index, false);
+		}
+		size_t count = storage.Size();
+		storage.Clear();
+		return count;
+	}
+
+	template<typename T>
+	static std::shared_ptr<void> CaptureSoAComponent(entt::entity e) {
+		SoAStorage<T>& storage = GetSoAStorage<T>();
+		return std::make_shared<T>(storage.Load(storage.Row(e)));
+	}
+
+	template<typename T>
+	static void CopySoAComponentToRange(const void* value, const entt::entity* first, const entt::entity* last) {
+		CreateSoAComponents<T>(first, last);
+
+		SoAStorage<T>& storage = GetSoAStorage<T>();
+		const T& prototype = *static_cast<const T*>(value);
+		for (auto it = first; it != last; it++) {
+			storage.Store(storage.Row(*it), prototype);
+		}
+	}
+
 	template<typename T>
 	static bool CopyComponent(entt::entity first, entt::entity second) {
 		if (HasComponent<T>(first) && HasComponent<T>(second)) {
 			T& firstComp = *GetComponent<T>(first);
 			T& secondComp = *GetComponent<T>(second);
 			secondComp = firstComp;
+			MarkComponentChanged<T>(second);
 			return true;
 		}
 		else {
@@ -478,10 +1157,26 @@ protected:
 
 	template<typename>
 	friend class RegisterObjectType;
+	template<typename>
+	friend class Prefab;
+	template<typename>
+	friend class DefinePodComponent;
+	template<typename>
+	friend class DefineSoAComponent;
+	template<typename, typename>
+	friend class DefineComponent;
 	friend class Object;
 
 private:
 
+	static RegisterState& State() {
+		return World::Current().Context<RegisterState>();
+	}
+
+	static ComponentTypeState& TypeState(ComponentIndex index) {
+		return State().m_ComponentTypeStates[index];
+	}
+
 	template<typename T>
 	static bool CallDestroyForObject(entt::entity e) {
 		if (!ObjectHandle(e)) {
@@ -496,45 +1191,132 @@ private:
 
 	}
 
-	static void ValidateAllGameObjects() {
-		Registry().each([](entt::entity e) {
-			for (auto& compName : ObjectPropertyRegister::GetObjectComponents(e)) {
-				auto handle = ObjectPropertyRegister::GetComponentByName(e, compName);
-				if (handle) {
-					Component& comp = *handle.Get();
-					comp.SetMaster(e);
-				}
+	// doomed must be sorted and unique, children left out of it are destroyed by a later batch
+	static void DestroyObjects(const std::vector<entt::entity>& doomed) {
+		auto isDoomed = [&](entt::entity e) {
+			return std::binary_search(doomed.begin(), doomed.end(), e);
+		};
+
+		std::vector<std::pair<ComponentIndex, entt::entity>> components;
+		for (auto e : doomed) {
+			ObjectProperties& properties = Registry().get<ObjectProperties>(e);
+
+			// surviving parents drop the deleted roots, nothing else outside the subtrees is visited
+			if (ObjectHandle parent = properties.m_Parent; parent && !isDoomed(parent.ID())) {
+				Registry().get<ObjectProperties>(parent.ID()).RemoveChildren(properties);
 			}
-			});
+
+			for (auto index : properties.m_ComponentIndices) {
+				components.emplace_back(index, e);
+			}
+		}
+
+		std::sort(components.begin(), components.end());
+		std::vector<entt::entity> run;
+		for (size_t begin = 0; begin < components.size();) {
+			size_t end = begin;
+			run.clear();
+			while (end < components.size() && components[end].first == components[begin].first) {
+				run.push_back(components[end].second);
+				end++;
+			}
+			m_ComponentTypes[components[begin].first].m_EraseRange(run.data(), run.data() + run.size());
+			begin = end;
+		}
+
+		std::vector<entt::id_type> poolsToPrune;
+		for (auto e : doomed) {
+			ObjectProperties& properties = Registry().get<ObjectProperties>(e);
+			if (auto destroyer = m_ObjectDestroyersByType.find(properties.m_MasterType); destroyer != m_ObjectDestroyersByType.end()) {
+				destroyer->second(e);
+			}
+			UnindexObjectName(e, properties.GetName());
+			if (Registry().all_of<ParkedObject>(e)) {
+				poolsToPrune.push_back(properties.m_MasterType);
+			}
+		}
+
+		// destroyed parked objects leave their pools, so pool sizes only count reusable objects
+		std::sort(poolsToPrune.begin(), poolsToPrune.end());
+		poolsToPrune.erase(std::unique(poolsToPrune.begin(), poolsToPrune.end()), poolsToPrune.end());
+		for (auto type : poolsToPrune) {
+			std::erase_if(State().m_ParkedObjectsByType[type], isDoomed);
+		}
+
+		Registry().destroy(doomed.begin(), doomed.end());
+		Hierarchy::MarkDirty();
 	}
 
+	
 
-	static std::string GetObjectType(entt::entity e) {
-		auto wholeStorage = Registry().storage();
 
-		for (auto [id, storage] : wholeStorage) {
-			if (m_RegisteredTypesByTag.find(id) != m_RegisteredTypesByTag.end()) {
-				return m_RegisteredObjectNames[m_RegisteredTypesByTag[id]];
+	static std::string GetBaseName(const std::string& name) {
+		// "Name(3)" shares the suffix counter of "Name"
+		if (name.size() < 3 || name.back() != ')') {
+			return name;
+		}
+		auto open = name.find_last_of('(');
+		if (open == std::string::npos || open == 0 || open + 2 > name.size() - 1) {
+			return name;
+		}
+		for (size_t i = open + 1; i < name.size() - 1; i++) {
+			if (!std::isdigit(static_cast<unsigned char>(name[i]))) {
+				return name;
 			}
 		}
+		return name.substr(0, open);
+	}
 
+	static std::string MakeUniqueName(std::string name) {
+		if (State().m_ObjectsByName.find(name) == State().m_ObjectsByName.end()) {
+			return name;
+		}
 
-		return "";
+		std::string baseName = GetBaseName(name);
+		int& index = State().m_NextNameSuffixByBaseName[baseName];
 
-	};
+		do {
+			index++;
+			name = baseName + "(" + std::to_string(index) + ")";
+		} while (State().m_ObjectsByName.find(name) != State().m_ObjectsByName.end());
 
-	
+		return name;
+	}
 
+	static void IndexObjectName(entt::entity e, const std::string& name) {
+		State().m_ObjectsByName.emplace(name, e);
+		State().m_NameCountByBaseName[GetBaseName(name)]++;
+	}
+
+	static void UnindexObjectName(entt::entity e, const std::string& name) {
+		auto [begin, end] = State().m_ObjectsByName.equal_range(name);
+		auto it = std::find_if(begin, end, [e](const auto& entry) { return entry.second == e; });
+		if (it == end) {
+			return;
+		}
+		State().m_ObjectsByName.erase(it);
+
+		// once neither the base name nor any of its suffixed names is left suffixes can start over
+		std::string baseName = GetBaseName(name);
+		auto count = State().m_NameCountByBaseName.find(baseName);
+		if (count != State().m_NameCountByBaseName.end() && --count->second == 0) {
+			State().m_NameCountByBaseName.erase(count);
+			State().m_NextNameSuffixByBaseName.erase(baseName);
+		}
+	}
 
 	static void GetAllChildren(ObjectHandle current, std::vector<ObjectHandle>& vec) {
 		if (!current) {
 			return;
 		}
+		// breadth first over vec itself, deep hierarchies don't grow the call stack
+		size_t next = vec.size();
 		vec.push_back(current);
-
-		for (auto& handle : Registry().get<ObjectProperties>(current.ID()).GetChildren()) {
-			if (handle) {
-				GetAllChildren(handle, vec);
+		for (; next < vec.size(); next++) {
+			for (auto& handle : Registry().get<ObjectProperties>(vec[next].ID()).GetChildren()) {
+				if (handle) {
+					vec.push_back(handle);
+				}
 			}
 		}
 	}
@@ -547,12 +1329,161 @@ private:
 		return GetComponent<T>(e);
 	};
 
+	template<typename T>
+	static size_t CreateComponents(const entt::entity* first, const entt::entity* last) {
+		return AddComponentToAll<T>(std::span<const entt::entity>(first, last));
+	};
+
+	template<typename T>
+	static size_t EraseComponents(const entt::entity* first, const entt::entity* last) {
+		return EraseComponentFromAll<T>(std::span<const entt::entity>(first, last));
+	};
+
+	template<typename T>
+	static std::shared_ptr<void> CaptureComponent(entt::entity e) {
+		return std::make_shared<T>(Registry().get<T>(e));
+	};
+
+	template<typename T>
+	static void CopyComponentToRange(const void* value, const entt::entity* first, const entt::entity* last) {
+		CreateComponents<T>(first, last);
+
+		auto& storage = Registry().storage<T>();
+		auto& ticks = Registry().storage<ComponentTicks<T>>();
+		const T& prototype = *static_cast<const T*>(value);
+
+		for (auto it = first; it != last; it++) {
+			storage.get(*it) = prototype;
+			ticks.get(*it).m_Changed = State().m_CurrentTick;
+		}
+	};
+
+	static void AddComponentToRangeByName(const entt::entity* first, const entt::entity* last, const std::string& componentName) {
+		if (ComponentIndex index = GetComponentIndexByName(componentName); index != NullComponentIndex) {
+			m_ComponentTypes[index].m_CreateRange(first, last);
+			return;
+		}
+
+		for (auto e = first; e != last; e++) {
+			AddComponentByName(*e, componentName);
+		}
+	}
+
 	template<typename T>
 	static void UpdateComponent(entt::entity e, float deltaTime);
 
+	template<typename T>
+	static constexpr bool OverridesUpdate() {
+		if constexpr (!IsVirtualComponent<T>) {
+			return false;
+		}
+		else {
+			return !requires { requires std::is_same<decltype(&T::Update), void(Component::*)(float)>::value; };
+		}
+	}
+
+	template<typename T>
+	static void UpdateComponentsInBucket(float deltaTime, uint32_t bucket, uint32_t bucketCount) {
+		auto view = Registry().view<T>(entt::exclude<ParkedObject, PendingDeletion>);
+
+		view.each([=](entt::entity e, T& comp) {
+			if (bucketCount > 1 && entt::to_entity(e) % bucketCount != bucket) {
+				return;
+			}
+
+			// storages hold exactly T, so when the override is reachable it can be called without the vtable
+			if constexpr (requires(T& c, float delta) { c.T::Update(delta); }) {
+				comp.T::Update(deltaTime);
+			}
+			else {
+				static_cast<Component&>(comp).Update(deltaTime);
+			}
+		});
+	}
+
+	template<typename T>
+	static void UpdateAllComponents(float deltaTime) {
+		if constexpr (OverridesUpdate<T>()) {
+			UpdateComponentsInBucket<T>(deltaTime, 0, 1);
+		}
+	}
+
+	static void TickComponentType(const ComponentTypeInfo& info, ComponentTypeState& state, float deltaTime) {
+		if (state.m_UpdateBuckets <= 1) {
+			info.m_UpdateBucket(deltaTime, 0, 1);
+			return;
+		}
+
+		for (auto& time : state.m_TimeSinceBucketUpdate) {
+			time += deltaTime;
+		}
+
+		uint32_t bucket = state.m_CurrentUpdateBucket;
+		info.m_UpdateBucket(state.m_TimeSinceBucketUpdate[bucket], bucket, state.m_UpdateBuckets);
+		state.m_TimeSinceBucketUpdate[bucket] = 0.0f;
+		state.m_CurrentUpdateBucket = (bucket + 1) % state.m_UpdateBuckets;
+	}
+
+	template<typename T>
+	static ComponentIndex RegisterComponentType() {
+		ComponentTypeInfo info;
+		info.m_Name = HelperFunctions::GetClassName<T>();
+		info.m_NameHash = HelperFunctions::HashClassName<T>();
+		info.m_TypeHash = entt::type_hash<T>().value();
+
+		if constexpr (IsSoAComponent<T>) {
+			// the storage address only tells the caller that the component exists
+			info.m_Create = [](entt::entity e) -> void* { AddSoAComponent<T>(e); return &GetSoAStorage<T>(); };
+			info.m_CastToBase = [](entt::entity) -> Component* { return nullptr; };
+			info.m_Update = [](entt::entity, float) {};
+			info.m_Copy = &CopySoAComponent<T>;
+			info.m_Erase = &EraseSoAComponent<T>;
+			info.m_Has = &HasSoAComponent<T>;
+
+			info.m_CreateRange = &CreateSoAComponents<T>;
+			info.m_EraseRange = &EraseSoAComponents<T>;
+			info.m_Clear = &ClearSoAComponent<T>;
+			info.m_Capture = &CaptureSoAComponent<T>;
+			info.m_CopyToRange = &CopySoAComponentToRange<T>;
+			info.m_CloneRange = &CloneSoAComponents<T>;
+		}
+		else {
+			info.m_Create = [](entt::entity e) -> void* { return CreateComponent<T>(e); };
+			info.m_CastToBase = &CastComponentToCommonBase<T>;
+			info.m_Update = &UpdateComponent<T>;
+			if constexpr (OverridesUpdate<T>()) {
+				info.m_UpdateBucket = &UpdateComponentsInBucket<T>;
+			}
+			info.m_Copy = &CopyComponent<T>;
+			info.m_Erase = &EraseComponent<T>;
+			info.m_Has = &HasComponent<T>;
+
+			info.m_CreateRange = &CreateComponents<T>;
+			info.m_EraseRange = &EraseComponents<T>;
+			info.m_Clear = &ClearComponent<T>;
+			info.m_Capture = &CaptureComponent<T>;
+			info.m_CopyToRange = &CopyComponentToRange<T>;
+			info.m_CloneRange = &CloneComponents<T>;
+		}
+
+		// command buffers may see a type for the first time on several workers at once
+		std::unique_lock<std::shared_mutex> lock(m_ComponentTypesMutex);
+		size_t count = m_ComponentTypeCount.load(std::memory_order_relaxed);
+		if (count >= ECSPP_MAX_COMPONENT_TYPES) {
+			throw std::runtime_error("Too many component types registered, define ECSPP_MAX_COMPONENT_TYPES with a bigger value!");
+		}
+
+		ComponentIndex index = static_cast<ComponentIndex>(count);
+		m_ComponentIndexByNameHash[info.m_NameHash] = index;
+		m_ComponentTypes[index] = std::move(info);
+		m_ComponentTypeCount.store(count + 1, std::memory_order_release);
+		return index;
+	}
+
 	template<typename T>
 	static entt::id_type RegisterClassAsComponent() {
 		entt::id_type hash = HelperFunctions::HashClassName<T>();
+		GetComponentIndex<T>();
 		entt::meta<T>().type(hash).template func<&CreateComponent<T>>(entt::hashed_string("Create Component"));
 		entt::meta<T>().type(hash).template func<&CastComponentToCommonBase<T>>(entt::hashed_string("Cast To Base"));
 		entt::meta<T>().type(hash).template func<&UpdateComponent<T>>(entt::hashed_string("Update Component"));
@@ -569,24 +1500,121 @@ private:
 
 
 	template<typename T>
-	static T DuplicateObject(T other) {
-		T obj = ObjectPropertyRegister::CreateNew<T>(other.Properties().GetName());
+	static void CreateObjects(const std::vector<std::string>& names, entt::entity* out) {
+		std::vector<T> objects = CreateMany<T>(names);
+		for (size_t i = 0; i < objects.size(); i++) {
+			out[i] = objects[i].ID();
+		}
+	};
 
-		for (auto [id, storage] : Registry().storage()) {
-			if (id == entt::type_hash<ObjectProperties>().value() || id == ObjectPropertyRegister::m_RegisteredTagsByType[HelperFunctions::HashClassName<T>()]) {
-				continue;
+	static void CloneComponentsOfSubtree(const std::vector<entt::entity>& sources, const std::vector<entt::entity>& clones) {
+		std::vector<std::tuple<ComponentIndex, entt::entity, entt::entity>> components;
+		for (size_t i = 0; i < sources.size(); i++) {
+			for (auto index : Registry().get<ObjectProperties>(sources[i]).m_ComponentIndices) {
+				components.emplace_back(index, sources[i], clones[i]);
 			}
-			if (storage.contains(other.ID()) && !storage.contains(obj.ID())) {
-				obj.AddComponentByName(GetComponentNameByID(id));
-				obj.CopyComponentByName(GetComponentNameByID(id), other);
+		}
+		std::sort(components.begin(), components.end());
+
+		std::vector<entt::entity> from(components.size());
+		std::vector<entt::entity> to(components.size());
+		std::vector<std::pair<size_t, size_t>> runs;
+		for (size_t i = 0; i < components.size(); i++) {
+			from[i] = std::get<1>(components[i]);
+			to[i] = std::get<2>(components[i]);
+			if (i == 0 || std::get<0>(components[i]) != std::get<0>(components[i - 1])) {
+				runs.emplace_back(i, i);
 			}
-			else if (storage.contains(obj.ID())) {
+			runs.back().second = i + 1;
+		}
+
+		// adding is structural so it stays on this thread, afterwards every run only writes to its own storage
+		for (auto [begin, end] : runs) {
+			m_ComponentTypes[std::get<0>(components[begin])].m_CreateRange(to.data() + begin, to.data() + end);
+		}
 
-				obj.CopyComponentByName(GetComponentNameByID(id), other);
+		EntityRemap remap(sources, clones);
+		auto cloneRun = [&](size_t run) {
+			auto [begin, end] = runs[run];
+			m_ComponentTypes[std::get<0>(components[begin])].m_CloneRange(from.data() + begin, to.data() + begin, end - begin, remap);
+		};
+
+		if (components.size() < ECSPP_PARALLEL_CLONE_THRESHOLD || runs.size() < 2) {
+			for (size_t run = 0; run < runs.size(); run++) {
+				cloneRun(run);
 			}
+			return;
 		}
 
-		return obj;
+		std::mutex mutex;
+		std::condition_variable done;
+		size_t remaining = runs.size();
+		std::exception_ptr exception;
+		World* world = &World::Current();
+
+		for (size_t run = 0; run < runs.size(); run++) {
+			ClonePool().Submit([&, run]() {
+				World::Scope scope(*world);
+				try {
+					cloneRun(run);
+				}
+				catch (...) {
+					std::lock_guard<std::mutex> lock(mutex);
+					if (!exception) {
+						exception = std::current_exception();
+					}
+				}
+
+				std::lock_guard<std::mutex> lock(mutex);
+				if (--remaining == 0) {
+					done.notify_all();
+				}
+			});
+		}
+
+		std::unique_lock<std::mutex> lock(mutex);
+		done.wait(lock, [&]() {
+			return remaining == 0;
+		});
+
+		if (exception) {
+			std::rethrow_exception(exception);
+		}
+	}
+
+	static ThreadPool& ClonePool() {
+		static ThreadPool pool;
+		return pool;
+	}
+
+	template<typename T>
+	static void CloneComponents(const entt::entity* sources, const entt::entity* destinations, size_t count, const EntityRemap& remap) {
+		auto& storage = Registry().storage<T>();
+		auto& ticks = Registry().storage<ComponentTicks<T>>();
+		Tick tick = State().m_CurrentTick;
+
+		for (size_t i = 0; i < count; i++) {
+			T& clone = storage.get(destinations[i]);
+			clone = storage.get(sources[i]);
+			ticks.get(destinations[i]).m_Changed = tick;
+
+			if constexpr (requires(T& c, const EntityRemap& r) { c.RemapEntities(r); }) {
+				clone.RemapEntities(remap);
+			}
+		}
+	};
+
+	template<typename T>
+	static void CloneSoAComponents(const entt::entity* sources, const entt::entity* destinations, size_t count, const EntityRemap& remap) {
+		SoAStorage<T>& storage = GetSoAStorage<T>();
+
+		for (size_t i = 0; i < count; i++) {
+			T value = storage.Load(storage.Row(sources[i]));
+			if constexpr (requires(T& c, const EntityRemap& r) { c.RemapEntities(r); }) {
+				value.RemapEntities(remap);
+			}
+			storage.Store(storage.Row(destinations[i]), value);
+		}
 	};
 
 	template<typename MainComponentType, typename FinalType>
@@ -597,7 +1625,7 @@ private:
 
 	template<typename Tag,typename Attached>
 	static void ForEachByTag(std::function<void(Attached)> func) {
-		auto view = Registry().view<Tag>();
+		auto view = Registry().view<Tag>(entt::exclude<ParkedObject, PendingDeletion>);
 		for (auto entity : view) {
 			func(Attached(entity));
 		}
@@ -608,17 +1636,23 @@ private:
 		m_ComponentsToMakeAvailableAtStartByType[HelperFunctions::HashClassName<T>()].push_back(HelperFunctions::GetClassName<Component>());
 	};
 
-	inline static std::vector<ObjectHandle> m_ObjectsToDelete;
 	inline static std::vector <std::string> m_ComponentsToMakeOmnipresent;
-	inline static std::unordered_map < entt::id_type, std::function<void(entt::entity)>> m_PropertyStorageContainer;
+	inline static std::unordered_map < entt::id_type, std::function<void(const entt::entity*, const entt::entity*)>> m_PropertyStorageContainer;
 	inline static std::unordered_map<entt::id_type, std::vector<std::string>> m_ComponentsToMakeAvailableAtStartByType;
-	inline static std::unordered_map<entt::id_type, std::function<void(entt::entity)>> m_RegisteredObjectTagsStartingFuncs;
+	inline static std::unordered_map<entt::id_type, std::function<void(const entt::entity*, const entt::entity*)>> m_RegisteredObjectTagsStartingFuncs;
+	inline static std::unordered_map<entt::id_type, bool(*)(entt::entity)> m_ObjectDestroyersByType;
+	inline static std::unordered_map<entt::id_type, void(*)(const std::vector<std::string>&, entt::entity*)> m_ObjectCreatorsByType;
 	inline static std::unordered_map<entt::id_type, std::vector<std::string>> m_RegisteredComponentsByType;
 	inline static std::unordered_map<entt::id_type, entt::id_type> m_RegisteredComponentByObjectType;
 	inline static std::unordered_map<entt::id_type, entt::id_type> m_RegisteredTagsByType;
 	inline static std::unordered_map<entt::id_type, entt::id_type> m_RegisteredTypesByTag;
 	inline static std::unordered_map<std::string, entt::id_type> m_RegisteredTagsByName;
 	inline static std::unordered_map<entt::id_type, std::string> m_RegisteredComponentsNames;
+	// fixed slots so that registering a type from inside Init or Update, or from another thread, never moves the entries
+	inline static std::array<ComponentTypeInfo, ECSPP_MAX_COMPONENT_TYPES> m_ComponentTypes;
+	inline static std::atomic<size_t> m_ComponentTypeCount = 0;
+	inline static std::shared_mutex m_ComponentTypesMutex;
+	inline static std::unordered_map<entt::id_type, ComponentIndex> m_ComponentIndexByNameHash;
 	inline static std::unordered_map<entt::id_type, std::string> m_RegisteredObjectNames;
 	
 	
@@ -626,6 +1660,83 @@ private:
 };
 
 
+inline ComponentHandle::ComponentHandle(entt::entity e, entt::id_type type) {
+	m_MasterID = e;
+	m_ComponentType = type;
+	m_ComponentIndex = ObjectPropertyRegister::GetComponentIndexByHash(type);
+};
+
+inline Component* ComponentHandle::Get() {
+	if (m_ComponentIndex == NullComponentIndex || !Registry().valid(m_MasterID)) {
+		ECSPP_DEBUG_LOG("Calling Get() without valid master id or component id");
+		return nullptr;
+	}
+
+	return ObjectPropertyRegister::GetComponentTypeInfo(m_ComponentIndex).m_CastToBase(m_MasterID);
+};
+
+inline ComponentHandle::operator bool() {
+	if (m_ComponentIndex == NullComponentIndex || !Registry().valid(m_MasterID)) {
+		return false;
+	}
+	return ObjectPropertyRegister::GetComponentTypeInfo(m_ComponentIndex).m_Has(m_MasterID);
+};
+
+/**
+ * Typed handle caching the address of T, looked up again only after instances may have moved.
+ */
+template<typename T>
+class ComponentRef {
+public:
+	ComponentRef() {
+
+	};
+
+	ComponentRef(entt::entity e) {
+		m_MasterID = e;
+	};
+
+	T* Get() {
+		uint64_t epoch = ObjectPropertyRegister::GetStorageEpoch<T>();
+		auto& storage = Registry().storage<T>();
+		// owning groups also swap instances around when other types or markers come and go, so the slot is checked too
+		if (m_Cached && m_Epoch == epoch && m_Index < storage.size() && storage.data()[m_Index] == m_MasterID) {
+			return m_Cached;
+		}
+
+		m_Cached = nullptr;
+		if (Registry().valid(m_MasterID) && storage.contains(m_MasterID)) {
+			m_Index = storage.index(m_MasterID);
+			m_Cached = &storage.get(m_MasterID);
+		}
+		m_Epoch = epoch;
+		return m_Cached;
+	};
+
+	T* operator->() {
+		return Get();
+	};
+
+	T& operator*() {
+		return *Get();
+	};
+
+	operator bool() {
+		return Get() != nullptr;
+	};
+
+	entt::entity GetMasterHandle() const {
+		return m_MasterID;
+	};
+
+private:
+	entt::entity m_MasterID = entt::null;
+	T* m_Cached = nullptr;
+	size_t m_Index = 0;
+	uint64_t m_Epoch = 0;
+
+};
+
 template<typename T>
 class NamedObjectHandle {
 public:
@@ -0,0 +1,102 @@
+#pragma once
+#include "object.h"
+
+
+namespace ecspp {
+
+/**
+ * Captured object subtree that can be instantiated in bulk.
+ */
+template<typename T>
+class Prefab {
+public:
+	Prefab(T object) {
+		static_assert(std::is_base_of<Object, T>::value);
+
+		CaptureNode(object.ID(), -1);
+	};
+
+	T Instantiate() {
+		return Instantiate(1)[0];
+	}
+
+	/**
+	 * Creates count copies of the captured hierarchy and returns their roots.
+	 */
+	std::vector<T> Instantiate(size_t count) {
+		if (count == 0) {
+			return {};
+		}
+
+		std::vector<std::vector<T>> objectsByNode(m_Nodes.size());
+		std::vector<entt::entity> entities(count);
+
+		for (size_t nodeIndex = 0; nodeIndex < m_Nodes.size(); nodeIndex++) {
+			Node& node = m_Nodes[nodeIndex];
+
+			objectsByNode[nodeIndex] = ObjectPropertyRegister::CreateMany<T>(count, node.m_Name);
+
+			std::vector<T>& objects = objectsByNode[nodeIndex];
+			for (size_t i = 0; i < count; i++) {
+				entities[i] = objects[i].ID();
+			}
+
+			for (auto& component : node.m_Components) {
+				component.m_CopyToRange(component.m_Value.get(), entities.data(), entities.data() + count);
+			}
+
+			if (node.m_Parent >= 0) {
+				std::vector<T>& parents = objectsByNode[node.m_Parent];
+				for (size_t i = 0; i < count; i++) {
+					objects[i].SetParent(parents[i]);
+				}
+			}
+		}
+
+		return objectsByNode[0];
+	}
+
+	size_t GetNumberOfNodes() const {
+		return m_Nodes.size();
+	}
+
+private:
+	struct ComponentSnapshot {
+		std::shared_ptr<void> m_Value;
+		void(*m_CopyToRange)(const void*, const entt::entity*, const entt::entity*) = nullptr;
+	};
+
+	struct Node {
+		std::string m_Name;
+		int m_Parent = -1;
+		std::vector<ComponentSnapshot> m_Components;
+	};
+
+	void CaptureNode(entt::entity e, int parent) {
+		ObjectProperties& properties = Registry().get<ObjectProperties>(e);
+
+		Node node;
+		node.m_Name = properties.GetName();
+		node.m_Parent = parent;
+
+		for (auto componentIndex : properties.GetComponentIndices()) {
+			const ComponentTypeInfo& info = ObjectPropertyRegister::GetComponentTypeInfo(componentIndex);
+
+			node.m_Components.push_back({ info.m_Capture(e), info.m_CopyToRange });
+		}
+
+		int index = static_cast<int>(m_Nodes.size());
+		m_Nodes.push_back(std::move(node));
+
+		for (auto& child : properties.GetChildren()) {
+			if (child) {
+				CaptureNode(child.ID(), index);
+			}
+		}
+	}
+
+	std::vector<Node> m_Nodes;
+
+};
+
+};
@@ -0,0 +1,255 @@
+#pragma once
+#include "tagged_object.h"
+#include <tuple>
+#include <span>
+
+
+namespace ecspp {
+
+template<typename... Types>
+struct With {};
+
+template<typename... Types>
+struct Without {};
+
+/**
+ * Query term matching components of type T added at or after the tick passed to Each/Count.
+ */
+template<typename T>
+struct Added {};
+
+/**
+ * Query term matching components of type T written at or after the tick passed to Each/Count.
+ */
+template<typename T>
+struct Changed {};
+
+namespace QueryHelpers {
+
+	template<typename... Types>
+	struct TypeList {};
+
+	template<typename... Lists>
+	struct Concat;
+
+	template<typename... Types>
+	struct Concat<TypeList<Types...>> {
+		using type = TypeList<Types...>;
+	};
+
+	template<typename... First, typename... Second, typename... Rest>
+	struct Concat<TypeList<First...>, TypeList<Second...>, Rest...> {
+		using type = typename Concat<TypeList<First..., Second...>, Rest...>::type;
+	};
+
+	// what a With entry contributes to the view and how it filters the matched entities
+	template<typename T>
+	struct Term {
+		using Data = T;
+		using Storages = TypeList<T>;
+
+		template<typename Tuple>
+		static bool Accept(const Tuple&, Tick) {
+			return true;
+		}
+	};
+
+	template<typename T>
+	struct Term<Added<T>> {
+		using Data = T;
+		using Storages = TypeList<T, ComponentTicks<T>>;
+
+		template<typename Tuple>
+		static bool Accept(const Tuple& tuple, Tick since) {
+			return std::get<ComponentTicks<T>&>(tuple).m_Added >= since;
+		}
+	};
+
+	template<typename T>
+	struct Term<Changed<T>> {
+		using Data = T;
+		using Storages = TypeList<T, ComponentTicks<T>>;
+
+		template<typename Tuple>
+		static bool Accept(const Tuple& tuple, Tick since) {
+			return std::get<ComponentTicks<T>&>(tuple).m_Changed >= since;
+		}
+	};
+
+	template<typename T>
+	struct IsObjectTag : std::false_type {};
+
+	template<typename Derived>
+	struct IsObjectTag<ObjectTag<Derived>> : std::true_type {};
+
+	// object tags and empty types only filter, they are not handed to the callbacks
+	template<typename T>
+	inline constexpr bool IsFilterOnly = IsObjectTag<T>::value || std::is_empty<T>::value;
+
+	template<typename Kept, typename... Types>
+	struct DataTypes;
+
+	template<typename... Kept>
+	struct DataTypes<TypeList<Kept...>> {
+		using type = TypeList<Kept...>;
+	};
+
+	template<typename... Kept, typename Head, typename... Tail>
+	struct DataTypes<TypeList<Kept...>, Head, Tail...> {
+		using type = typename std::conditional_t<IsFilterOnly<Head>,
+			DataTypes<TypeList<Kept...>, Tail...>,
+			DataTypes<TypeList<Kept..., Head>, Tail...>>::type;
+	};
+
+	template<typename... Excluded, typename... Types>
+	auto MakeView(TypeList<Types...>) {
+		return Registry().view<Types...>(entt::exclude<ParkedObject, PendingDeletion, Excluded...>);
+	}
+
+	template<typename... Excluded, typename... Types>
+	auto MakeGroup(TypeList<Types...>) {
+		return Registry().group<Types...>(entt::get<>, entt::exclude<ParkedObject, PendingDeletion, Excluded...>);
+	}
+
+	template<typename First, typename... Rest>
+	First Front(TypeList<First, Rest...>);
+
+	template<typename Data>
+	std::span<Data> ChunkOf(size_t offset, size_t length) {
+		constexpr size_t pageSize = entt::component_traits<Data>::page_size;
+		return std::span<Data>(Registry().storage<Data>().raw()[offset / pageSize] + offset % pageSize, length);
+	}
+
+	// chunks never cross a storage page, so each span is contiguous memory
+	template<typename Func, typename... Data>
+	void EachChunk(const entt::entity* entities, size_t count, Func& func, TypeList<Data...>) {
+		static_assert(((!entt::component_traits<Data>::in_place_delete) && ...), "Pointer stable components leave holes and can't be iterated in chunks!");
+		// empty types have no pages, a zero chunk size would never advance
+		static_assert(sizeof...(Data) > 0 && ((entt::component_traits<Data>::page_size > 0) && ...), "Tags and empty types have no instances to iterate in chunks!");
+
+		constexpr size_t chunkSize = std::min({ entt::component_traits<Data>::page_size... });
+		for (size_t offset = 0; offset < count; offset += chunkSize) {
+			size_t length = std::min(chunkSize, count - offset);
+			func(std::span<const entt::entity>(entities + offset, length), ChunkOf<Data>(offset, length)...);
+		}
+	}
+
+	template<typename Func, typename Tuple, typename... Data>
+	void Invoke(Func& func, Tuple&& tuple, TypeList<Data...>) {
+		if constexpr (std::is_invocable<Func&, entt::entity, Data&...>::value) {
+			func(std::get<0>(tuple), std::get<Data&>(tuple)...);
+		}
+		else {
+			func(std::get<Data&>(tuple)...);
+		}
+	}
+
+};
+
+/**
+ * Iterates objects having every With type and none of the Without types.
+ * Tags only filter, Added/Changed terms compare against since.
+ */
+template<typename WithList, typename WithoutList = Without<>>
+class Query;
+
+template<typename... Included, typename... Excluded>
+class Query<With<Included...>, Without<Excluded...>> {
+public:
+	using DataList = typename QueryHelpers::DataTypes<QueryHelpers::TypeList<>, typename QueryHelpers::Term<Included>::Data...>::type;
+	using StorageList = typename QueryHelpers::Concat<typename QueryHelpers::Term<Included>::Storages...>::type;
+
+	static auto View() {
+		return QueryHelpers::MakeView<Excluded...>(StorageList{});
+	}
+
+	template<typename Func>
+	static void Each(Func func, Tick since = 0) {
+		for (auto tuple : View().each()) {
+			if ((QueryHelpers::Term<Included>::Accept(tuple, since) && ...)) {
+				QueryHelpers::Invoke(func, tuple, DataList{});
+			}
+		}
+	}
+
+	static size_t Count(Tick since = 0) {
+		size_t count = 0;
+		for (auto tuple : View().each()) {
+			if ((QueryHelpers::Term<Included>::Accept(tuple, since) && ...)) {
+				count++;
+			}
+		}
+		return count;
+	}
+
+};
+
+/**
+ * Query backed by an entt owning group, a type can only be owned by one group.
+ */
+template<typename WithList, typename WithoutList = Without<>>
+class OwningQuery;
+
+template<typename... Included, typename... Excluded>
+class OwningQuery<With<Included...>, Without<Excluded...>> {
+public:
+	using DataList = typename QueryHelpers::DataTypes<QueryHelpers::TypeList<>, typename QueryHelpers::Term<Included>::Data...>::type;
+	using StorageList = typename QueryHelpers::Concat<typename QueryHelpers::Term<Included>::Storages...>::type;
+
+	static auto Group() {
+		return QueryHelpers::MakeGroup<Excluded...>(StorageList{});
+	}
+
+	template<typename Func>
+	static void Each(Func func, Tick since = 0) {
+		for (auto tuple : Group().each()) {
+			if ((QueryHelpers::Term<Included>::Accept(tuple, since) && ...)) {
+				QueryHelpers::Invoke(func, tuple, DataList{});
+			}
+		}
+	}
+
+	/**
+	 * Calls func(entities, components...) over contiguous page sized chunks, not for Added/Changed terms.
+	 */
+	template<typename Func>
+	static void EachChunk(Func func) {
+		static_assert((std::is_same<typename QueryHelpers::Term<Included>::Storages, QueryHelpers::TypeList<Included>>::value && ...), "Chunks can't be filtered by ticks!");
+
+		auto group = Group();
+		using FrontType = decltype(QueryHelpers::Front(StorageList{}));
+		QueryHelpers::EachChunk(Registry().storage<FrontType>().data(), group.size(), func, DataList{});
+	}
+
+	static size_t Count(Tick since = 0) {
+		if constexpr ((std::is_same<typename QueryHelpers::Term<Included>::Storages, QueryHelpers::TypeList<Included>>::value && ...)) {
+			return Group().size();
+		}
+		else {
+			size_t count = 0;
+			for (auto tuple : Group().each()) {
+				if ((QueryHelpers::Term<Included>::Accept(tuple, since) && ...)) {
+					count++;
+				}
+			}
+			return count;
+		}
+	}
+
+};
+
+/**
+ * Hands func contiguous spans of entities and components, several types go through their owning group.
+ */
+template<typename... Types, typename Func>
+void ForEachChunk(Func func) {
+	if constexpr (sizeof...(Types) == 1) {
+		auto& storage = Registry().storage<Types...>();
+		QueryHelpers::EachChunk(storage.data(), storage.size(), func, QueryHelpers::TypeList<Types...>{});
+	}
+	else {
+		OwningQuery<With<Types...>>::EachChunk(func);
+	}
+}
+
+};
@@ -1,16 +1,29 @@
 #pragma once
-#include "../helpers/helpers.h"
-#include "../../vendor/entt/single_include/entt/entt.hpp"
+#include "world.h"
 #include <ctime>
 #include <random>
-#include "../global.h"
 
 namespace ecspp {
 
-    inline entt::registry& Registry() {
-        static entt::registry m_Registry;
+    inline std::pmr::memory_resource* GetMemoryResource() {
+        return World::Current().GetMemoryResource();
+    };
+
+    /**
+     * Sets the memory resource of the default world, only before the registry is first used.
+     */
+    inline void SetMemoryResource(std::pmr::memory_resource* resource) {
+        if (RegistryHelpers::RegistryCreated()) {
+            throw std::runtime_error("The memory resource must be set before the registry is first used!");
+        }
+        RegistryHelpers::MemoryResource() = resource;
+    };
 
-        return m_Registry;
+    /**
+     * Registry of the world current on the calling thread.
+     */
+    inline RegistryType& Registry() {
+        return World::Current().GetRegistry();
     };
 
     namespace ComponentHelpers {
@@ -24,4 +37,4 @@ namespace ecspp {
 
 
     
-};
\ No newline at end of file
+};
@@ -77,16 +77,36 @@ public:
 		return ObjectPropertyRegister::CreateNew<Derived>(name,std::forward<Args>(args)...);
 	}
 
+	static std::vector<Derived> CreateMany(size_t count, std::string baseName) {
+		return ObjectPropertyRegister::CreateMany<Derived>(count, baseName);
+	}
+
+	/**
+	 * Reuses a parked object of this type, calling Reset instead of Init, or creates a new one.
+	 */
+	static Derived CreateFromPool(std::string name) {
+		return ObjectPropertyRegister::AcquireFromPool<Derived>(name);
+	}
+
+	/**
+	 * Parks this object and its children with their components intact, they are hidden from ForEach until handed out again.
+	 */
+	bool ReleaseToPool() {
+		return ObjectPropertyRegister::ReleaseToPool(ObjectHandle(this->ID()));
+	}
+
+	static size_t GetNumberOfPooledObjects() {
+		return ObjectPropertyRegister::GetNumberOfPooledObjects<Derived>();
+	}
+
+	static void ClearPool() {
+		ObjectPropertyRegister::ClearPool<Derived>();
+	}
+
 
 	void ForSelfAndEachChild(std::function<void(Derived)> func) {
-		func(*((Derived*)this));
-		if (GetChildren().size() == 0) {
-			return;
-		}
-		for (auto id : GetChildren()) {
-			if(id){
-				id.template GetAs<Derived>().ForSelfAndEachChild(func);
-			}
+		for (auto e : this->GetSelfAndDescendants()) {
+			func(Derived(e));
 		}
 	};
 
@@ -144,6 +164,7 @@ private:
 	using Object::GetComponent;
 	using Object::GetComponentByName;
 	using Object::GetComponentsNames;
+	using Object::GetComponentsIndices;
 	using Object::HasComponent;
 };
 
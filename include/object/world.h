@@ -0,0 +1,137 @@
+#pragma once
+#include "../helpers/helpers.h"
+#include "../../vendor/entt/single_include/entt/entt.hpp"
+#include <memory_resource>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <array>
+#include <mutex>
+#include "../global.h"
+
+namespace ecspp {
+
+    using RegistryAllocator = std::pmr::polymorphic_allocator<entt::entity>;
+    using RegistryType = entt::basic_registry<entt::entity, RegistryAllocator>;
+
+    namespace RegistryHelpers {
+        inline std::pmr::memory_resource*& MemoryResource() {
+            static std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+            return resource;
+        }
+
+        inline bool& RegistryCreated() {
+            static bool created = false;
+            return created;
+        }
+    };
+
+    /**
+     * Registry and per scene state, ecspp calls act on the world current on the calling thread.
+     * Component types are shared by all worlds, debug builds throw when an Object is used under another world.
+     */
+    class World {
+    public:
+        World(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : m_MemoryResource(resource), m_Registry(RegistryAllocator(resource)) {
+
+        };
+
+        World(const World&) = delete;
+        World& operator=(const World&) = delete;
+
+        ~World() {
+            if (CurrentSlot() == this) {
+                CurrentSlot() = nullptr;
+            }
+        };
+
+        RegistryType& GetRegistry() {
+            return m_Registry;
+        };
+
+        std::pmr::memory_resource* GetMemoryResource() const {
+            return m_MemoryResource;
+        };
+
+        /**
+         * Per world instance of T, created on first use. Safe to call from several threads, only the creation locks.
+         */
+        template<typename T>
+        T& Context() {
+            static const size_t slot = NextContextSlot()++;
+            if (slot >= ECSPP_MAX_WORLD_CONTEXTS) {
+                throw std::runtime_error("Too many world context types, define ECSPP_MAX_WORLD_CONTEXTS with a bigger value!");
+            }
+
+            if (void* context = m_Contexts[slot].load(std::memory_order_acquire)) {
+                return *static_cast<T*>(context);
+            }
+
+            std::lock_guard<std::mutex> lock(m_ContextMutex);
+            if (void* context = m_Contexts[slot].load(std::memory_order_relaxed)) {
+                return *static_cast<T*>(context);
+            }
+            std::shared_ptr<void>& owned = m_OwnedContexts.emplace_back(std::make_shared<T>());
+            m_Contexts[slot].store(owned.get(), std::memory_order_release);
+            return *static_cast<T*>(owned.get());
+        };
+
+        /**
+         * Makes a world current on the calling thread until the scope ends.
+         */
+        class Scope {
+        public:
+            Scope(World& world) : m_Previous(CurrentSlot()) {
+                CurrentSlot() = &world;
+            };
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+            ~Scope() {
+                CurrentSlot() = m_Previous;
+            };
+
+        private:
+            World* m_Previous = nullptr;
+        };
+
+        template<typename Func>
+        decltype(auto) Run(Func&& func) {
+            Scope scope(*this);
+            return func();
+        };
+
+        static World& Current() {
+            World* world = CurrentSlot();
+            return world ? *world : Default();
+        };
+
+        static World& Default() {
+            static World world([]() {
+                RegistryHelpers::RegistryCreated() = true;
+                return RegistryHelpers::MemoryResource();
+            }());
+            return world;
+        };
+
+    private:
+        static World*& CurrentSlot() {
+            thread_local World* current = nullptr;
+            return current;
+        };
+
+        static std::atomic<size_t>& NextContextSlot() {
+            static std::atomic<size_t> slot = 0;
+            return slot;
+        };
+
+        std::pmr::memory_resource* m_MemoryResource = nullptr;
+        RegistryType m_Registry;
+        std::array<std::atomic<void*>, ECSPP_MAX_WORLD_CONTEXTS> m_Contexts{};
+        std::mutex m_ContextMutex;
+        // declared last so the contexts go away before the registry
+        std::vector<std::shared_ptr<void>> m_OwnedContexts;
+    };
+
+};
@@ -0,0 +1,234 @@
+#pragma once
+#include "../object/object.h"
+#include "../helpers/thread_pool.h"
+#include <exception>
+#include <algorithm>
+
+
+namespace ecspp {
+
+template<typename... Types>
+struct Reads {};
+
+template<typename... Types>
+struct Writes {};
+
+/**
+ * Per frame work declaring the component types it reads and writes, it must not make structural changes.
+ * GetComponent counts as a write, Reads<T> use Object::ReadComponent.
+ */
+class System {
+public:
+	virtual ~System() {};
+
+	const std::string& GetName() const {
+		return m_Name;
+	}
+
+	bool ConflictsWith(const System& other) const {
+		for (auto id : m_Writes) {
+			if (other.IsReading(id) || other.IsWriting(id)) {
+				return true;
+			}
+		}
+		for (auto id : other.m_Writes) {
+			if (IsReading(id)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool IsReading(entt::id_type id) const {
+		return std::find(m_Reads.begin(), m_Reads.end(), id) != m_Reads.end();
+	}
+
+	bool IsWriting(entt::id_type id) const {
+		return std::find(m_Writes.begin(), m_Writes.end(), id) != m_Writes.end();
+	}
+
+protected:
+	virtual void Update(float deltaTime) {};
+
+private:
+	template<typename... ReadTypes, typename... WriteTypes>
+	void SetAccess(Reads<ReadTypes...>, Writes<WriteTypes...>) {
+		(m_Reads.push_back(entt::type_hash<ReadTypes>().value()), ...);
+		(m_Writes.push_back(entt::type_hash<WriteTypes>().value()), ...);
+		(m_StorageInitializers.push_back([]() { Registry().storage<ReadTypes>(); Registry().storage<ComponentTicks<ReadTypes>>(); }), ...);
+		(m_StorageInitializers.push_back([]() { Registry().storage<WriteTypes>(); Registry().storage<ComponentTicks<WriteTypes>>(); }), ...);
+	}
+
+	std::string m_Name;
+	std::vector<entt::id_type> m_Reads;
+	std::vector<entt::id_type> m_Writes;
+	std::vector<void(*)()> m_StorageInitializers;
+
+	template<typename, typename, typename>
+	friend class DefineSystem;
+	friend class SystemScheduler;
+
+};
+
+template<typename Derived, typename ReadSet = Reads<>, typename WriteSet = Writes<>>
+class DefineSystem : public System {
+public:
+	DefineSystem() {
+		m_Name = HelperFunctions::GetClassName<Derived>();
+		SetAccess(ReadSet{}, WriteSet{});
+	};
+};
+
+/**
+ * Runs systems on a thread pool, conflicting ones in the order they were added.
+ */
+class SystemScheduler {
+public:
+	SystemScheduler(size_t threadCount = std::thread::hardware_concurrency()) : m_Pool(threadCount) {
+
+	};
+
+	template<typename T, typename... Args>
+	T& AddSystem(Args&&... args) {
+		static_assert(std::is_base_of<System, T>::value, "Class is not derived from System!");
+
+		T* system = new T(std::forward<Args>(args)...);
+		m_Systems.push_back(std::unique_ptr<System>(system));
+		m_GraphDirty = true;
+		return *system;
+	}
+
+	template<typename... ReadTypes, typename... WriteTypes>
+	System& AddSystem(std::string name, Reads<ReadTypes...> reads, Writes<WriteTypes...> writes, std::function<void(float)> func) {
+		FunctionSystem& system = AddSystem<FunctionSystem>(std::move(func));
+		system.m_Name = name;
+		system.SetAccess(reads, writes);
+		return system;
+	}
+
+	void Run(float deltaTime) {
+		if (m_Systems.size() == 0) {
+			return;
+		}
+
+		if (m_GraphDirty) {
+			BuildGraph();
+		}
+
+		// creating storages is a structural change, so it can't happen inside the systems
+		Registry().storage<ParkedObject>();
+		Registry().storage<PendingDeletion>();
+		for (auto& system : m_Systems) {
+			for (auto initializer : system->m_StorageInitializers) {
+				initializer();
+			}
+		}
+
+		std::vector<std::atomic<size_t>> waitingFor(m_Systems.size());
+		for (size_t i = 0; i < m_Systems.size(); i++) {
+			waitingFor[i] = m_Dependencies[i];
+		}
+
+		FrameState state;
+		state.m_Remaining = m_Systems.size();
+		state.m_World = &World::Current();
+
+		for (size_t i = 0; i < m_Systems.size(); i++) {
+			if (m_Dependencies[i] == 0) {
+				Dispatch(i, deltaTime, waitingFor, state);
+			}
+		}
+
+		std::unique_lock<std::mutex> lock(state.m_Mutex);
+		state.m_Done.wait(lock, [&]() {
+			return state.m_Remaining == 0;
+		});
+
+		if (state.m_Exception) {
+			std::rethrow_exception(state.m_Exception);
+		}
+	}
+
+	size_t GetNumberOfSystems() const {
+		return m_Systems.size();
+	}
+
+	size_t GetNumberOfThreads() const {
+		return m_Pool.GetNumberOfThreads();
+	}
+
+private:
+	class FunctionSystem : public System {
+	public:
+		FunctionSystem(std::function<void(float)> func) : m_Function(std::move(func)) {};
+
+	protected:
+		void Update(float deltaTime) override {
+			m_Function(deltaTime);
+		};
+
+	private:
+		std::function<void(float)> m_Function;
+	};
+
+	struct FrameState {
+		std::mutex m_Mutex;
+		std::condition_variable m_Done;
+		size_t m_Remaining = 0;
+		std::exception_ptr m_Exception;
+		World* m_World = nullptr;
+	};
+
+	void BuildGraph() {
+		m_Dependents.assign(m_Systems.size(), {});
+		m_Dependencies.assign(m_Systems.size(), 0);
+
+		for (size_t later = 0; later < m_Systems.size(); later++) {
+			for (size_t earlier = 0; earlier < later; earlier++) {
+				if (m_Systems[earlier]->ConflictsWith(*m_Systems[later])) {
+					m_Dependents[earlier].push_back(later);
+					m_Dependencies[later]++;
+				}
+			}
+		}
+
+		m_GraphDirty = false;
+	}
+
+	void Dispatch(size_t index, float deltaTime, std::vector<std::atomic<size_t>>& waitingFor, FrameState& state) {
+		m_Pool.Submit([this, index, deltaTime, &waitingFor, &state]() {
+			// the workers act on the world Run was called from
+			World::Scope scope(*state.m_World);
+			try {
+				m_Systems[index]->Update(deltaTime);
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(state.m_Mutex);
+				if (!state.m_Exception) {
+					state.m_Exception = std::current_exception();
+				}
+			}
+
+			for (auto dependent : m_Dependents[index]) {
+				if (--waitingFor[dependent] == 0) {
+					Dispatch(dependent, deltaTime, waitingFor, state);
+				}
+			}
+
+			std::lock_guard<std::mutex> lock(state.m_Mutex);
+			if (--state.m_Remaining == 0) {
+				state.m_Done.notify_all();
+			}
+		});
+	}
+
+	std::vector<std::unique_ptr<System>> m_Systems;
+	std::vector<std::vector<size_t>> m_Dependents;
+	std::vector<size_t> m_Dependencies;
+	bool m_GraphDirty = false;
+
+	ThreadPool m_Pool;
+
+};
+
+};
@@ -28,7 +28,10 @@ public:
         return Storage();
     }
 
-    
+protected:
+    void Reset() override {
+        Storage().hello++;
+    }
 };
 
 class OtherOtherClass {
@@ -226,6 +229,21 @@ TEST_CASE("Copying objects without knowing their type") {
 
     REQUIRE(secondHandle.GetAsObject().GetComponent<RandomComponent>().valueOne == 3);
 
+    ecspp::ObjectHandle plain = ecspp::CreateNewObject("Plain");
+    ecspp::ObjectHandle plainChild = ecspp::CreateNewObject("PlainChild");
+    plainChild.GetAsObject().SetParent(plain.GetAsObject());
+    plainChild.GetAsObject().AddComponent<RandomComponent>().valueOne = 5;
+
+    ecspp::ObjectHandle plainCopy = ecspp::CopyObject(plain);
+
+    REQUIRE(plainCopy.operator bool());
+    REQUIRE(plainCopy.ID() != plain.ID());
+    REQUIRE(plainCopy.GetAsObject().GetChildren().size() == 1);
+
+    ecspp::Object copiedChild = plainCopy.GetAsObject().GetChildren()[0].GetAsObject();
+    REQUIRE(copiedChild.ID() != plainChild.ID());
+    REQUIRE(copiedChild.GetComponent<RandomComponent>().valueOne == 5);
+
 }
 
 TEST_CASE("Testing Storage") {
@@ -265,6 +283,209 @@ TEST_CASE("Many Objects") {
 
 }
 
+TEST_CASE("Unique names and finding objects by name") {
+
+    ecspp::DeleteAllObjects();
+
+    TestObject first = TestObject::CreateNew("Bullet");
+    TestObject second = TestObject::CreateNew("Bullet");
+    TestObject third = TestObject::CreateNew("Bullet");
+
+    REQUIRE(first.GetName() == "Bullet");
+    REQUIRE(second.GetName() == "Bullet(1)");
+    REQUIRE(third.GetName() == "Bullet(2)");
+
+    REQUIRE(ecspp::FindObjectByName("Bullet(1)").ID() == second.ID());
+
+    second.SetName("Renamed");
+
+    REQUIRE(!ecspp::FindObjectByName("Bullet(1)"));
+    REQUIRE(ecspp::FindObjectByName("Renamed").ID() == second.ID());
+
+    REQUIRE(ecspp::DeleteObject(third));
+
+    ecspp::ClearDeletingQueue();
+
+    REQUIRE(!ecspp::FindObjectByName("Bullet(2)"));
+    REQUIRE(ecspp::FindObjectByName("Bullet").ID() == first.ID());
+
+    // suffixes keep counting while any object of the base name is left
+    TestObject fourth = TestObject::CreateNew("Bullet");
+    REQUIRE(fourth.GetName() == "Bullet(3)");
+
+    REQUIRE(ecspp::DeleteObject(first));
+    ecspp::ClearDeletingQueue();
+
+    REQUIRE(TestObject::CreateNew("Bullet").GetName() == "Bullet");
+    REQUIRE(TestObject::CreateNew("Bullet").GetName() == "Bullet(4)");
+
+    ecspp::DeleteAllObjects();
+
+    REQUIRE(!ecspp::FindObjectByName("Bullet"));
+    REQUIRE(TestObject::CreateNew("Bullet").GetName() == "Bullet");
+    REQUIRE(TestObject::CreateNew("Bullet").GetName() == "Bullet(1)");
+
+}
+
+TEST_CASE("Creating many objects at once") {
+
+    ecspp::DeleteAllObjects();
+
+    std::vector<TestObject> objects = TestObject::CreateMany(1000, "Spawned");
+
+    REQUIRE(objects.size() == 1000);
+    REQUIRE(TestObject::GetNumberOfObjects() == 1000);
+
+    REQUIRE(objects[0].GetName() == "Spawned");
+    REQUIRE(objects[1].GetName() == "Spawned(1)");
+    REQUIRE(objects[999].GetName() == "Spawned(999)");
+
+    REQUIRE(objects[500].GetType() == "TestObject");
+    REQUIRE(objects[500].GetStorage().hello == 0);
+    REQUIRE(objects[500].Empty());
+
+    REQUIRE(ecspp::FindObjectByName("Spawned(500)").ID() == objects[500].ID());
+
+    ecspp::DeleteAllObjects();
+
+    REQUIRE(TestObject::GetNumberOfObjects() == 0);
+
+}
+
+TEST_CASE("Recycling objects through the pool") {
+
+    ecspp::DeleteAllObjects();
+
+    TestObject obj = TestObject::CreateNew("Projectile");
+    obj.AddComponent<RandomComponent>().valueOne = 5;
+
+    entt::entity id = obj.ID();
+
+    REQUIRE(obj.ReleaseToPool());
+    REQUIRE(!obj.ReleaseToPool());
+
+    REQUIRE(TestObject::GetNumberOfObjects() == 0);
+    REQUIRE(TestObject::GetNumberOfPooledObjects() == 1);
+    REQUIRE(!ecspp::FindObjectByName("Projectile"));
+
+    TestObject recycled = TestObject::CreateFromPool("Projectile");
+
+    REQUIRE(recycled.ID() == id);
+    REQUIRE(recycled.GetName() == "Projectile");
+    REQUIRE(recycled.GetStorage().hello == 1);
+    REQUIRE(recycled.GetComponent<RandomComponent>().valueOne == 5);
+    REQUIRE(TestObject::GetNumberOfObjects() == 1);
+    REQUIRE(TestObject::GetNumberOfPooledObjects() == 0);
+
+    TestObject fresh = TestObject::CreateFromPool("Projectile");
+
+    REQUIRE(fresh.ID() != id);
+    REQUIRE(fresh.GetStorage().hello == 0);
+
+    // objects being deleted can't be pooled, destroyed parked objects leave the pool
+    REQUIRE(ecspp::DeleteObject(fresh));
+    REQUIRE(!fresh.ReleaseToPool());
+    REQUIRE(recycled.ReleaseToPool());
+    REQUIRE(TestObject::GetNumberOfPooledObjects() == 1);
+
+    // a parked object marked for deletion is never handed out again
+    REQUIRE(ecspp::DeleteObject(ecspp::ObjectHandle(id)));
+    TestObject replacement = TestObject::CreateFromPool("Projectile");
+    REQUIRE(replacement.ID() != id);
+    ecspp::ClearDeletingQueue();
+    REQUIRE(replacement.Valid());
+
+    ecspp::DeleteAllObjects();
+
+    REQUIRE(TestObject::GetNumberOfPooledObjects() == 0);
+
+}
+
+TEST_CASE("Instantiating prefabs") {
+
+    ecspp::DeleteAllObjects();
+
+    TestObject enemy = TestObject::CreateNew("Enemy");
+    TestObject weapon = TestObject::CreateNew("Weapon");
+
+    enemy.AddComponent<RandomComponent>().valueOne = 10;
+    weapon.AddComponent<RandomComponent>().valueTwo = 20;
+    weapon.SetParent(enemy);
+
+    ecspp::Prefab<TestObject> prefab(enemy);
+
+    REQUIRE(prefab.GetNumberOfNodes() == 2);
+
+    std::vector<TestObject> copies = prefab.Instantiate(50);
+
+    REQUIRE(copies.size() == 50);
+    REQUIRE(TestObject::GetNumberOfObjects() == 102);
+
+    for (auto& copy : copies) {
+        REQUIRE(copy.GetComponent<RandomComponent>().valueOne == 10);
+        REQUIRE(copy.GetComponentsNames().size() == 1);
+        REQUIRE(copy.GetChildren().size() == 1);
+
+        TestObject child = copy.GetChildren()[0].GetAs<TestObject>();
+
+        REQUIRE(child.GetParent().ID() == copy.ID());
+        REQUIRE(child.GetComponent<RandomComponent>().valueTwo == 20);
+    }
+
+    ecspp::DeleteAllObjects();
+
+}
+
+TEST_CASE("Tracking components per object") {
+
+    ecspp::DeleteAllObjects();
+
+    TestObject obj = TestObject::CreateNew("Tracked");
+
+    REQUIRE(obj.Empty());
+    REQUIRE(!obj.HasComponent("RandomComponent"));
+    REQUIRE(!obj.HasComponent("NotAComponent"));
+
+    obj.AddComponent<RandomComponent>();
+
+    REQUIRE(!obj.Empty());
+    REQUIRE(obj.HasComponent("RandomComponent"));
+    REQUIRE(ecspp::GetObjectComponents(obj) == std::vector<std::string>{ "RandomComponent" });
+
+    obj.EraseComponentByName("RandomComponent");
+
+    REQUIRE(obj.Empty());
+    REQUIRE(!obj.HasComponent("RandomComponent"));
+    REQUIRE(obj.GetComponentsNames().size() == 0);
+
+    ecspp::DeleteAllObjects();
+
+}
+
+TEST_CASE("Calling component functions by name") {
+
+    ecspp::DeleteAllObjects();
+
+    TestObject first = TestObject::CreateNew("First");
+    TestObject second = TestObject::CreateNew("Second");
+
+    REQUIRE(!first.EraseComponentByName("RandomComponent"));
+    REQUIRE(!first.EraseComponentByName("NotAComponent"));
+
+    first.AddComponentByName("RandomComponent").GetAs<RandomComponent>()->valueOne = 7;
+    second.AddComponentByName("RandomComponent");
+
+    REQUIRE(second.CopyComponentByName("RandomComponent", first));
+    REQUIRE(second.GetComponent<RandomComponent>().valueOne == 7);
+    REQUIRE(second.GetComponentByName("RandomComponent").Get()->GetMasterHandle() == second.ID());
+
+    REQUIRE(first.EraseComponentByName("RandomComponent"));
+    REQUIRE(!first.HasComponent<RandomComponent>());
+
+    ecspp::DeleteAllObjects();
+
+}
+
 template<typename Derived>
 struct TestTemplatedDerived : public ecspp::RegisterObjectType<Derived> {
 public:
@@ -297,6 +518,1010 @@ struct OtherTestComponent : public ecspp::DefineComponent<OtherTestComponent,Tes
 
 };
 
+struct CountingComponent : public ecspp::DefineComponent<CountingComponent,TestComponent> {
+public:
+    void Update(float delta) override {
+        totalTime += delta;
+        updates++;
+    };
+
+    float totalTime = 0;
+    int updates = 0;
+};
+
+TEST_CASE("Updating all components by storage") {
+
+    ecspp::DeleteAllObjects();
+
+    std::vector<TestObject> objects = TestObject::CreateMany(10, "Updated");
+
+    for (auto& obj : objects) {
+        obj.AddComponent<CountingComponent>();
+    }
+
+    objects[0].ReleaseToPool();
+
+    ecspp::UpdateAll(0.5f);
+    CountingComponent::UpdateAll(0.5f);
+
+    REQUIRE(objects[0].GetComponent<CountingComponent>().updates == 0);
+
+    for (size_t i = 1; i < objects.size(); i++) {
+        REQUIRE(objects[i].GetComponent<CountingComponent>().updates == 2);
+        REQUIRE(objects[i].GetComponent<CountingComponent>().totalTime == 1.0f);
+    }
+
+    ecspp::DeleteAllObjects();
+
+}
+
+struct FixedRateComponent : public ecspp::DefineComponent<FixedRateComponent,TestComponent> {
+public:
+    void Update(float delta) override {
+        totalTime += delta;
+        updates++;
+    };
+
+    float totalTime = 0;
+    int updates = 0;
+};
+
+struct StaggeredComponent : public ecspp::DefineComponent<StaggeredComponent,TestComponent> {
+public:
+    void Update(float delta) override {
+        totalTime += delta;
+        updates++;
+    };
+
+    float totalTime = 0;
+    int updates = 0;
+};
+
+TEST_CASE("Updating components at their own rate") {
+
+    ecspp::DeleteAllObjects();
+
+    FixedRateComponent::SetUpdateRate(2.0f);
+    StaggeredComponent::SetUpdateStagger(2);
+
+    std::vector<TestObject> objects = TestObject::CreateMany(4, "Rated");
+
+    for (auto& obj : objects) {
+        obj.AddComponent<FixedRateComponent>();
+        obj.AddComponent<StaggeredComponent>();
+    }
+
+    ecspp::UpdateAll(0.25f);
+
+    for (auto& obj : objects) {
+        bool firstBucket = entt::to_entity(obj.ID()) % 2 == 0;
+
+        REQUIRE(obj.GetComponent<FixedRateComponent>().updates == 0);
+        REQUIRE(obj.GetComponent<StaggeredComponent>().updates == (firstBucket ? 1 : 0));
+    }
+
+    ecspp::UpdateAll(0.25f);
+
+    for (auto& obj : objects) {
+        bool firstBucket = entt::to_entity(obj.ID()) % 2 == 0;
+
+        REQUIRE(obj.GetComponent<FixedRateComponent>().updates == 1);
+        REQUIRE(obj.GetComponent<FixedRateComponent>().totalTime == 0.5f);
+        REQUIRE(obj.GetComponent<StaggeredComponent>().updates == 1);
+        REQUIRE(obj.GetComponent<StaggeredComponent>().totalTime == (firstBucket ? 0.25f : 0.5f));
+    }
+
+    ecspp::UpdateAll(1.0f);
+
+    for (auto& obj : objects) {
+        REQUIRE(obj.GetComponent<FixedRateComponent>().updates == 3);
+    }
+
+    // rates are set per world
+    ecspp::World other;
+    other.Run([]() {
+        TestObject obj = TestObject::CreateNew("Unrated");
+        obj.AddComponent<FixedRateComponent>();
+        ecspp::UpdateAll(0.25f);
+        REQUIRE(obj.GetComponent<FixedRateComponent>().updates == 1);
+    });
+
+    FixedRateComponent::SetUpdateRate(0.0f);
+    StaggeredComponent::SetUpdateStagger(1);
+
+    ecspp::DeleteAllObjects();
+
+}
+
+struct FrozenComponent : public ecspp::DefineComponent<FrozenComponent,TestComponent> {
+
+};
+
+struct PositionComponent : public ecspp::DefineComponent<PositionComponent,TestComponent> {
+public:
+    float x = 0;
+    float y = 0;
+};
+
+struct VelocityComponent : public ecspp::DefineComponent<VelocityComponent,TestComponent> {
+public:
+    float x = 1;
+    float y = 2;
+};
+
+TEST_CASE("Querying objects by components and tags") {
+
+    ecspp::DeleteAllObjects();
+
+    std::vector<TestObject> objects = TestObject::CreateMany(10, "Queried");
+
+    for (size_t i = 0; i < objects.size(); i++) {
+        objects[i].AddComponent<PositionComponent>();
+        objects[i].AddComponent<VelocityComponent>();
+        if (i < 3) {
+            objects[i].AddComponent<FrozenComponent>();
+        }
+    }
+
+    FinalDerived other = FinalDerived::CreateNew("Other");
+    other.AddComponent<PositionComponent>();
+    other.AddComponent<VelocityComponent>();
+
+    using MovingTestObjects = ecspp::Query<ecspp::With<ecspp::ObjectTag<TestObject>, PositionComponent, VelocityComponent>, ecspp::Without<FrozenComponent>>;
+
+    REQUIRE(MovingTestObjects::Count() == 7);
+
+    MovingTestObjects::Each([](PositionComponent& position, VelocityComponent& velocity) {
+        position.x += velocity.x;
+        position.y += velocity.y;
+    });
+
+    MovingTestObjects::Each([](entt::entity e, PositionComponent& position, VelocityComponent& velocity) {
+        REQUIRE(position.GetMasterHandle() == e);
+    });
+
+    for (size_t i = 0; i < objects.size(); i++) {
+        REQUIRE(objects[i].GetComponent<PositionComponent>().x == (i < 3 ? 0.0f : 1.0f));
+    }
+    REQUIRE(other.GetComponent<PositionComponent>().x == 0.0f);
+
+    using Moving = ecspp::OwningQuery<ecspp::With<PositionComponent, VelocityComponent>>;
+
+    REQUIRE(Moving::Count() == 11);
+
+    Moving::Each([](entt::entity e, PositionComponent& position, VelocityComponent& velocity) {
+        REQUIRE(position.GetMasterHandle() == e);
+        REQUIRE(velocity.GetMasterHandle() == e);
+    });
+
+    ecspp::DeleteAllObjects();
+
+}
+
+TEST_CASE("Detecting added and changed components") {
+
+    ecspp::DeleteAllObjects();
+
+    ecspp::Tick since = ecspp::AdvanceTick();
+
+    std::vector<TestObject> objects = TestObject::CreateMany(5, "Tracked");
+    for (auto& obj : objects) {
+        obj.AddComponent<VelocityComponent>();
+    }
+
+    using AddedVelocities = ecspp::Query<ecspp::With<ecspp::Added<VelocityComponent>>>;
+    using ChangedVelocities = ecspp::Query<ecspp::With<ecspp::Changed<VelocityComponent>>>;
+
+    REQUIRE(AddedVelocities::Count(since) == 5);
+
+    since = ecspp::AdvanceTick();
+
+    REQUIRE(AddedVelocities::Count(since) == 0);
+    REQUIRE(ChangedVelocities::Count(since) == 0);
+
+    objects[1].GetComponent<VelocityComponent>().x = 5;
+    objects[3].Patch<VelocityComponent>([](VelocityComponent& velocity) {
+        velocity.y = 3;
+    });
+
+    std::vector<entt::entity> changed;
+    ChangedVelocities::Each([&](entt::entity e, VelocityComponent& velocity) {
+        changed.push_back(e);
+    }, since);
+
+    REQUIRE(changed.size() == 2);
+    REQUIRE(std::find(changed.begin(), changed.end(), objects[1].ID()) != changed.end());
+    REQUIRE(std::find(changed.begin(), changed.end(), objects[3].ID()) != changed.end());
+
+    since = ecspp::AdvanceTick();
+
+    objects[4].MarkDirty<VelocityComponent>();
+    REQUIRE(ChangedVelocities::Count(since) == 1);
+
+    objects[4].EraseComponent<VelocityComponent>();
+    REQUIRE(ChangedVelocities::Count(since) == 0);
+
+    // reading through handles, casts and updates doesn't count as a change
+    since = ecspp::AdvanceTick();
+    objects[0].ForEachComponent([](ecspp::ComponentHandle& handle) {
+        REQUIRE(handle.Get() != nullptr);
+    });
+    REQUIRE(objects[0].GetComponentByName("VelocityComponent").GetAs<VelocityComponent>() != nullptr);
+    ecspp::UpdateAll(0.1f);
+    REQUIRE(ChangedVelocities::Count(since) == 0);
+
+    ecspp::DeleteAllObjects();
+
+}
+
+struct StableComponent : public ecspp::DefineComponent<StableComponent,TestComponent>, public ecspp::PointerStable {
+public:
+    int value = 0;
+};
+
+TEST_CASE("Caching component references") {
+
+    ecspp::DeleteAllObjects();
+
+    std::vector<TestObject> objects = TestObject::CreateMany(4, "Referenced");
+    for (size_t i = 0; i < objects.size(); i++) {
+        objects[i].AddComponent<VelocityComponent>().x = static_cast<float>(i);
+        objects[i].AddComponent<StableComponent>().value = static_cast<int>(i);
+    }
+
+    ecspp::ComponentRef<VelocityComponent> velocity = objects[3].GetComponentRef<VelocityComponent>();
+    REQUIRE(velocity);
+    REQUIRE(velocity->x == 3.0f);
+
+    ecspp::ComponentHandle handle(objects[1].ID(), ecspp::HelperFunctions::HashClassName<VelocityComponent>());
+    REQUIRE(handle);
+
+    objects[1].EraseComponent<VelocityComponent>();
+    REQUIRE(!handle);
+
+    // the last instance was moved into the erased slot, the reference resolves it again
+    REQUIRE(velocity);
+    REQUIRE(velocity->GetMasterHandle() == objects[3].ID());
+    velocity->x = 7.0f;
+    REQUIRE(objects[3].GetComponent<VelocityComponent>().x == 7.0f);
+
+    ecspp::ComponentRef<StableComponent> stable = objects[3].GetComponentRef<StableComponent>();
+    StableComponent* address = stable.Get();
+    objects[0].EraseComponent<StableComponent>();
+    REQUIRE(stable.Get() == address);
+    REQUIRE(stable->value == 3);
+
+    objects[3].EraseComponent<VelocityComponent>();
+    REQUIRE(!velocity);
+
+    ecspp::DeleteObject(objects[3]);
+    ecspp::ClearDeletingQueue();
+    REQUIRE(!stable);
+
+    ecspp::DeleteAllObjects();
+
+}
+
+TEST_CASE("Caching component references owned by a group") {
+
+    ecspp::DeleteAllObjects();
+
+    std::vector<TestObject> objects = TestObject::CreateMany(4, "Grouped");
+    for (size_t i = 0; i < objects.size(); i++) {
+        objects[i].AddComponent<PositionComponent>().x = static_cast<float>(i);
+        objects[i].AddComponent<VelocityComponent>();
+    }
+
+    using Moving = ecspp::OwningQuery<ecspp::With<PositionComponent, VelocityComponent>>;
+    REQUIRE(Moving::Count() == 4);
+
+    ecspp::ComponentRef<PositionComponent> position = objects[3].GetComponentRef<PositionComponent>();
+    REQUIRE(position->x == 3.0f);
+
+    // the pending marker is excluded by the group, which swaps the last grouped instances into the deleted object's slot
+    ecspp::DeleteObject(objects[0]);
+    REQUIRE(Moving::Count() == 3);
+    REQUIRE(position->GetMasterHandle() == objects[3].ID());
+    REQUIRE(position->x == 3.0f);
+
+    ecspp::ClearDeletingQueue();
+    REQUIRE(position->GetMasterHandle() == objects[3].ID());
+
+    // assigning a fresh value keeps the owner
+    objects[3].GetComponent<PositionComponent>() = PositionComponent();
+    REQUIRE(objects[3].GetComponent<PositionComponent>().GetMasterHandle() == objects[3].ID());
+    REQUIRE(objects[3].GetComponent<PositionComponent>().GetMasterObject().ID() == objects[3].ID());
+
+    // erasing moves the last instance into the freed slot
+    objects[1].EraseComponent<VelocityComponent>();
+    REQUIRE(objects[2].GetComponent<VelocityComponent>().GetMasterHandle() == objects[2].ID());
+    REQUIRE(objects[3].GetComponent<VelocityComponent>().GetMasterHandle() == objects[3].ID());
+
+    ecspp::DeleteAllObjects();
+
+}
+
+TEST_CASE("Adding and erasing components in bulk") {
+
+    ecspp::DeleteAllObjects();
+
+    std::vector<TestObject> objects = TestObject::CreateMany(100, "Buffed");
+    std::vector<entt::entity> ids;
+    for (auto& obj : objects) {
+        ids.push_back(obj.ID());
+    }
+
+    objects[0].AddComponent<VelocityComponent>().x = 10.0f;
+
+    REQUIRE(ecspp::AddComponentToAll<VelocityComponent>(ids) == 99);
+    REQUIRE(objects[0].GetComponent<VelocityComponent>().x == 10.0f);
+    REQUIRE(objects[50].HasComponent("VelocityComponent"));
+    REQUIRE(objects[50].GetComponent<VelocityComponent>().GetMasterHandle() == objects[50].ID());
+
+    std::vector<entt::entity> half(ids.begin(), ids.begin() + 50);
+    REQUIRE(ecspp::EraseComponentFromAll<VelocityComponent>(half) == 50);
+    REQUIRE(!objects[10].HasComponent("VelocityComponent"));
+    REQUIRE(objects[60].HasComponent("VelocityComponent"));
+    REQUIRE(VelocityComponent::AliveCount() == 50);
+
+    REQUIRE(ecspp::AddComponentToAll(half, "VelocityComponent") == 50);
+    REQUIRE(objects[10].GetComponentsNames().size() == 1);
+
+    REQUIRE(ecspp::EraseComponentFromAll(half, "VelocityComponent") == 50);
+
+    // listing an entity twice erases it once
+    std::vector<entt::entity> repeated = { ids[60], ids[61], ids[60] };
+    REQUIRE(ecspp::EraseComponentFromAll<VelocityComponent>(repeated) == 2);
+    REQUIRE(ecspp::ClearComponent<VelocityComponent>() == 48);
+    REQUIRE(objects[60].Empty());
+    REQUIRE(ecspp::ClearComponent("NotAComponent") == 0);
+
+    ecspp::DeleteAllObjects();
+
+}
+
+struct HealthComponent : public ecspp::DefinePodComponent<HealthComponent> {
+public:
+    int16_t health = 100;
+    uint8_t flags = 0;
+};
+
+TEST_CASE("Using plain data components") {
+
+    static_assert(sizeof(HealthComponent) == 4);
+    static_assert(std::is_trivially_copyable<HealthComponent>::value);
+
+    ecspp::DeleteAllObjects();
+
+    TestObject first = TestObject::CreateNew("Healthy");
+    TestObject second = TestObject::CreateNew("Healthy");
+
+    first.AddComponent<HealthComponent>().health -= 10;
+    REQUIRE(first.HasComponent("HealthComponent"));
+    REQUIRE(first.GetComponentsNames()[0] == "HealthComponent");
+
+    auto handle = second.AddComponentByName("HealthComponent");
+    REQUIRE(handle);
+    REQUIRE(handle.Get() == nullptr);
+    REQUIRE(handle.GetAs<HealthComponent>()->health == 100);
+
+    REQUIRE(second.CopyComponentByName("HealthComponent", first));
+    REQUIRE(second.GetComponent<HealthComponent>().health == 90);
+
+    ecspp::UpdateAll(0.1f);
+
+    int total = 0;
+    HealthComponent::ForEach([&](entt::entity e, HealthComponent& comp) {
+        total += comp.health;
+    });
+    REQUIRE(total == 180);
+
+    REQUIRE(ecspp::Query<ecspp::With<ecspp::ObjectTag<TestObject>, HealthComponent>>::Count() == 2);
+
+    REQUIRE(second.EraseComponentByName("HealthComponent"));
+    REQUIRE(!handle);
+    REQUIRE(HealthComponent::AliveCount() == 1);
+
+    ecspp::DeleteAllObjects();
+    REQUIRE(HealthComponent::AliveCount() == 0);
+
+}
+
+struct TransformSoA : public ecspp::DefineSoAComponent<TransformSoA> {
+public:
+    float x = 0;
+    float y = 0;
+    float z = 0;
+
+    static constexpr auto Fields = std::make_tuple(&TransformSoA::x, &TransformSoA::y, &TransformSoA::z);
+};
+
+TEST_CASE("Storing components as structure of arrays") {
+
+    ecspp::DeleteAllObjects();
+
+    std::vector<TestObject> objects = TestObject::CreateMany(4, "Columns");
+    for (size_t i = 0; i < objects.size(); i++) {
+        objects[i].AddComponent<TransformSoA>().Get<&TransformSoA::x>() = static_cast<float>(i);
+    }
+
+    REQUIRE(objects[2].HasComponent("TransformSoA"));
+    REQUIRE(objects[2].HasComponent<TransformSoA>());
+    REQUIRE(TransformSoA::AliveCount() == 4);
+
+    auto xs = TransformSoA::Column<&TransformSoA::x>();
+    auto ys = TransformSoA::Column<&TransformSoA::y>();
+    REQUIRE(xs.size() == 4);
+    for (size_t i = 0; i < xs.size(); i++) {
+        ys[i] = xs[i] * 2.0f;
+    }
+    REQUIRE(objects[3].GetComponent<TransformSoA>().Get<&TransformSoA::y>() == 6.0f);
+
+    TransformSoA value = objects[1].GetComponent<TransformSoA>().Load();
+    REQUIRE(value.x == 1.0f);
+    REQUIRE(value.y == 2.0f);
+    value.z = 5.0f;
+    objects[1].GetComponent<TransformSoA>().Store(value);
+
+    REQUIRE(objects[0].EraseComponent<TransformSoA>());
+    REQUIRE(TransformSoA::AliveCount() == 3);
+    REQUIRE(objects[3].GetComponent<TransformSoA>().Get<&TransformSoA::x>() == 3.0f);
+    REQUIRE(objects[1].GetComponent<TransformSoA>().Get<&TransformSoA::z>() == 5.0f);
+
+    TestObject other = TestObject::CreateNew("Columns");
+    REQUIRE(other.AddComponentByName("TransformSoA"));
+    REQUIRE(other.CopyComponentByName("TransformSoA", objects[1]));
+    REQUIRE(other.GetComponent<TransformSoA>().Get<&TransformSoA::z>() == 5.0f);
+
+    ecspp::DeleteAllObjects();
+    REQUIRE(TransformSoA::AliveCount() == 0);
+
+}
+
+TEST_CASE("Iterating components in chunks") {
+
+    ecspp::DeleteAllObjects();
+
+    std::vector<TestObject> objects = TestObject::CreateMany(3000, "Chunked");
+    std::vector<entt::entity> ids;
+    for (auto& obj : objects) {
+        ids.push_back(obj.ID());
+    }
+    ecspp::AddComponentToAll<HealthComponent>(ids);
+
+    size_t total = 0;
+    size_t chunks = 0;
+    ecspp::ForEachChunk<HealthComponent>([&](std::span<const entt::entity> entities, std::span<HealthComponent> health) {
+        REQUIRE(entities.size() == health.size());
+        REQUIRE(health.size() <= entt::component_traits<HealthComponent>::page_size);
+        for (auto& comp : health) {
+            comp.health -= 1;
+        }
+        total += health.size();
+        chunks++;
+    });
+
+    REQUIRE(total == 3000);
+    REQUIRE(chunks == (3000 + entt::component_traits<HealthComponent>::page_size - 1) / entt::component_traits<HealthComponent>::page_size);
+    REQUIRE(objects[1234].GetComponent<HealthComponent>().health == 99);
+
+    for (size_t i = 0; i < 10; i++) {
+        objects[i].AddComponent<PositionComponent>();
+        objects[i].AddComponent<VelocityComponent>();
+    }
+
+    ecspp::ForEachChunk<PositionComponent, VelocityComponent>([](std::span<const entt::entity> entities, std::span<PositionComponent> positions, std::span<VelocityComponent> velocities) {
+        for (size_t i = 0; i < entities.size(); i++) {
+            REQUIRE(positions[i].GetMasterHandle() == entities[i]);
+            REQUIRE(velocities[i].GetMasterHandle() == entities[i]);
+            positions[i].x += velocities[i].x;
+        }
+    });
+
+    REQUIRE(objects[5].GetComponent<PositionComponent>().x == 1.0f);
+
+    ecspp::DeleteAllObjects();
+
+}
+
+TEST_CASE("Using custom memory resources") {
+
+    ecspp::Registry();
+
+    REQUIRE(ecspp::GetMemoryResource() == std::pmr::get_default_resource());
+    REQUIRE(ecspp::Registry().get_allocator().resource() == ecspp::GetMemoryResource());
+    REQUIRE_THROWS(ecspp::SetMemoryResource(std::pmr::new_delete_resource()));
+
+    TestObject obj = TestObject::CreateNew("Allocated");
+    REQUIRE(ecspp::Registry().get<ecspp::ObjectProperties>(obj.ID()).GetChildren().get_allocator().resource() == ecspp::GetMemoryResource());
+
+    ecspp::HugePageResource hugePages;
+    std::pmr::unsynchronized_pool_resource pool(&hugePages);
+    std::pmr::vector<int> values(&pool);
+    for (int i = 0; i < 100000; i++) {
+        values.push_back(i);
+    }
+    REQUIRE(values[99999] == 99999);
+
+    ecspp::DeleteAllObjects();
+
+}
+
+TEST_CASE("Running independent worlds") {
+
+    ecspp::DeleteAllObjects();
+
+    TestObject inDefault = TestObject::CreateNew("Shared");
+
+    ecspp::World first;
+    ecspp::World second;
+
+    first.Run([]() {
+        REQUIRE(TestObject::GetNumberOfObjects() == 0);
+
+        TestObject obj = TestObject::CreateNew("Shared");
+        obj.AddComponent<VelocityComponent>();
+
+        // names are indexed per world
+        REQUIRE(obj.GetName() == "Shared");
+        REQUIRE(ecspp::FindObjectByName("Shared").GetAsObject().ID() == obj.ID());
+    });
+
+    REQUIRE(ecspp::FindObjectByName("Shared").GetAsObject().ID() == inDefault.ID());
+    REQUIRE(!inDefault.HasComponent("VelocityComponent"));
+
+#ifndef NDEBUG
+    // objects can't be used under a world they don't belong to
+    REQUIRE_THROWS(first.Run([&]() { return inDefault.GetName(); }));
+#endif
+
+    std::thread firstThread([&]() {
+        ecspp::World::Scope scope(first);
+        for (int i = 0; i < 100; i++) {
+            TestObject::CreateNew("Threaded");
+        }
+    });
+    std::thread secondThread([&]() {
+        ecspp::World::Scope scope(second);
+        for (int i = 0; i < 50; i++) {
+            TestObject::CreateNew("Threaded");
+        }
+    });
+    firstThread.join();
+    secondThread.join();
+
+    REQUIRE(first.Run([]() { return TestObject::GetNumberOfObjects(); }) == 101);
+    REQUIRE(second.Run([]() { return TestObject::GetNumberOfObjects(); }) == 50);
+    REQUIRE(TestObject::GetNumberOfObjects() == 1);
+
+    first.Run([]() { ecspp::DeleteAllObjects(); });
+    second.Run([]() { ecspp::DeleteAllObjects(); });
+    ecspp::DeleteAllObjects();
+
+}
+
+TEST_CASE("Deferring structural changes through command buffers") {
+
+    ecspp::DeleteAllObjects();
+
+    TestObject parent = TestObject::CreateNew("Parent");
+    TestObject doomed = TestObject::CreateNew("Doomed");
+    doomed.AddComponent<VelocityComponent>();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&]() {
+            ecspp::CommandBuffer& commands = ecspp::Commands();
+            for (int i = 0; i < 25; i++) {
+                ecspp::PendingObject spawned = commands.Create<TestObject>("Spawned");
+                commands.AddComponent<VelocityComponent>(spawned);
+                commands.AddComponent<PositionComponent>(spawned);
+                commands.SetParent(spawned, parent.ID());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ecspp::CommandBuffer& commands = ecspp::Commands();
+    commands.SetName(parent.ID(), "Renamed");
+    commands.EraseComponent<VelocityComponent>(doomed.ID());
+    commands.Destroy(doomed.ID());
+
+    REQUIRE(TestObject::GetNumberOfObjects() == 2);
+
+    ecspp::PlaybackCommands();
+
+    REQUIRE(TestObject::GetNumberOfObjects() == 101);
+    REQUIRE(!doomed.Valid());
+    REQUIRE(parent.GetName() == "Renamed");
+    REQUIRE(parent.GetChildren().size() == 100);
+    REQUIRE(ecspp::Query<ecspp::With<PositionComponent, VelocityComponent>>::Count() == 100);
+
+    for (auto& child : parent.GetChildren()) {
+        REQUIRE(child.GetAsObject().GetComponent<VelocityComponent>().GetMasterHandle() == child.GetAsObject().ID());
+    }
+
+    REQUIRE(ecspp::Commands().Empty());
+
+    // a placeholder from an earlier playback doesn't resolve to what the reused buffer creates next
+    ecspp::CommandBuffer reused;
+    ecspp::PendingObject stale = reused.Create<TestObject>("First");
+    reused.Playback();
+    reused.Create<TestObject>("Second");
+    reused.AddComponent<PositionComponent>(stale);
+    reused.Playback();
+    REQUIRE(ecspp::FindObjectByName("Second").GetAsObject().GetComponentsNames().empty());
+
+    ecspp::DeleteAllObjects();
+
+}
+
+TEST_CASE("Deleting subtrees without touching other objects") {
+
+    ecspp::DeleteAllObjects();
+
+    TestObject root = TestObject::CreateNew("Root");
+    TestObject branch = TestObject::CreateNew("Branch");
+    TestObject leaf = TestObject::CreateNew("Leaf");
+    TestObject other = TestObject::CreateNew("Other");
+
+    branch.SetParent(root);
+    leaf.SetParent(branch);
+
+    for (auto obj : { root, branch, leaf, other }) {
+        obj.AddComponent<VelocityComponent>();
+        obj.AddComponent<PositionComponent>();
+    }
+
+    // queueing an object together with its parent must not destroy it twice
+    REQUIRE(ecspp::DeleteObject(leaf));
+    REQUIRE(ecspp::DeleteObject(branch));
+    ecspp::ClearDeletingQueue();
+
+    REQUIRE(!branch.Valid());
+    REQUIRE(!leaf.Valid());
+    REQUIRE(TestObject::GetNumberOfObjects() == 2);
+    REQUIRE(root.GetChildren().size() == 0);
+    REQUIRE(ecspp::Query<ecspp::With<VelocityComponent, PositionComponent>>::Count() == 2);
+
+    // the erased components were swapped out of their storages, the survivors keep their masters
+    REQUIRE(root.GetComponent<VelocityComponent>().GetMasterHandle() == root.ID());
+    REQUIRE(other.GetComponent<VelocityComponent>().GetMasterHandle() == other.ID());
+    REQUIRE(other.GetComponent<PositionComponent>().GetMasterHandle() == other.ID());
+
+    ecspp::DeleteAllObjects();
+
+    REQUIRE(TestObject::GetNumberOfObjects() == 0);
+
+}
+
+TEST_CASE("Clearing the deleting queue over several frames") {
+
+    ecspp::DeleteAllObjects();
+
+    TestObject root = TestObject::CreateNew("Root");
+    root.AddComponent<VelocityComponent>();
+    for (int i = 0; i < 9; i++) {
+        TestObject child = TestObject::CreateNew("Child");
+        child.AddComponent<VelocityComponent>();
+        child.SetParent(root);
+    }
+    TestObject survivor = TestObject::CreateNew("Survivor");
+    survivor.AddComponent<VelocityComponent>();
+
+    REQUIRE(ecspp::DeleteObject(root));
+
+    // pending objects are hidden before they are destroyed
+    REQUIRE(TestObject::GetNumberOfObjects() == 1);
+    REQUIRE(ecspp::Query<ecspp::With<VelocityComponent>>::Count() == 1);
+
+    size_t visited = 0;
+    VelocityComponent::ForEach([&](VelocityComponent&) { visited++; });
+    REQUIRE(visited == 1);
+
+    REQUIRE(!ecspp::ClearDeletingQueue(4));
+    REQUIRE(VelocityComponent::AliveCount() == 7);
+
+    REQUIRE(!ecspp::ClearDeletingQueue(4));
+    REQUIRE(ecspp::ClearDeletingQueue(4));
+    REQUIRE(VelocityComponent::AliveCount() == 1);
+
+    REQUIRE(!root.Valid());
+
+    REQUIRE(ecspp::DeleteObject(survivor));
+    REQUIRE(ecspp::ClearDeletingQueue(100, std::chrono::milliseconds(16)));
+    REQUIRE(!survivor.Valid());
+
+    TestObject keeper = TestObject::CreateNew("Keeper");
+    TestObject doomedParent = TestObject::CreateNew("Doomed Parent");
+    TestObject doomedChild = TestObject::CreateNew("Doomed Child");
+    TestObject adopted = TestObject::CreateNew("Adopted");
+    doomedChild.SetParent(doomedParent);
+
+    REQUIRE(ecspp::DeleteObject(doomedParent));
+
+    // moving out of a deleted subtree doesn't save an object, moving into one dooms it
+    doomedChild.SetParent(keeper);
+    adopted.SetParent(doomedParent);
+    REQUIRE(TestObject::GetNumberOfObjects() == 1);
+
+    REQUIRE(ecspp::ClearDeletingQueue(100));
+    REQUIRE(!doomedChild.Valid());
+    REQUIRE(!adopted.Valid());
+    REQUIRE(keeper.GetChildren().size() == 0);
+
+    ecspp::DeleteAllObjects();
+
+}
+
+TEST_CASE("Walking the flattened hierarchy") {
+
+    ecspp::DeleteAllObjects();
+
+    TestObject root = TestObject::CreateNew("Root");
+    TestObject first = TestObject::CreateNew("First");
+    TestObject second = TestObject::CreateNew("Second");
+    TestObject grandchild = TestObject::CreateNew("Grandchild");
+    TestObject other = TestObject::CreateNew("Other");
+
+    first.SetParent(root);
+    second.SetParent(root);
+    grandchild.SetParent(first);
+
+    REQUIRE(root.IsInChildren(grandchild));
+    REQUIRE(!first.IsInChildren(second));
+    REQUIRE(grandchild.GetDepth() == 2);
+    REQUIRE(other.GetDepth() == 0);
+    REQUIRE(other.GetDescendants().empty());
+
+    std::vector<entt::entity> expected = { first.ID(), grandchild.ID(), second.ID() };
+    auto descendants = root.GetDescendants();
+    REQUIRE(std::vector<entt::entity>(descendants.begin(), descendants.end()) == expected);
+
+    // moving a subtree detaches it from its old parent
+    first.SetParent(other);
+    REQUIRE(root.GetChildren().size() == 1);
+    REQUIRE(!root.IsInChildren(grandchild));
+    REQUIRE(other.IsInChildren(grandchild));
+    REQUIRE(grandchild.GetDepth() == 2);
+
+    // a parent can't become a child of its own subtree
+    other.SetParent(grandchild);
+    REQUIRE(!other.GetParent());
+
+    size_t visited = 0;
+    other.ForSelfAndEachChild([&](TestObject) { visited++; });
+    REQUIRE(visited == 3);
+
+    // adding and removing children keeps the parent links in sync
+    root.AddChildren(first);
+    REQUIRE(first.GetParent().ID() == root.ID());
+    REQUIRE(other.GetChildren().empty());
+    REQUIRE(root.GetChildren().size() == 2);
+    expected = { second.ID(), first.ID(), grandchild.ID() };
+    descendants = root.GetDescendants();
+    REQUIRE(std::vector<entt::entity>(descendants.begin(), descendants.end()) == expected);
+
+    root.AddChildren(first);
+    REQUIRE(root.GetChildren().size() == 2);
+
+    root.RemoveChildren(first);
+    REQUIRE(!first.GetParent());
+    REQUIRE(first.GetDepth() == 0);
+    REQUIRE(!root.IsInChildren(grandchild));
+    expected = { grandchild.ID() };
+    descendants = first.GetDescendants();
+    REQUIRE(std::vector<entt::entity>(descendants.begin(), descendants.end()) == expected);
+
+    ecspp::DeleteAllObjects();
+
+}
+
+struct LayerComponent : public ecspp::DefineComponent<LayerComponent,TestComponent> {
+public:
+    int local = 1;
+    int world = 1;
+};
+
+TEST_CASE("Propagating components down dirty subtrees") {
+
+    ecspp::DeleteAllObjects();
+
+    TestObject root = TestObject::CreateNew("Root");
+    TestObject child = TestObject::CreateNew("Child");
+    TestObject grandchild = TestObject::CreateNew("Grandchild");
+    TestObject otherRoot = TestObject::CreateNew("Other Root");
+    TestObject otherChild = TestObject::CreateNew("Other Child");
+
+    child.SetParent(root);
+    grandchild.SetParent(child);
+    otherChild.SetParent(otherRoot);
+
+    for (auto obj : { root, child, grandchild, otherRoot, otherChild }) {
+        obj.AddComponent<LayerComponent>();
+    }
+
+    auto combine = [](const LayerComponent& parent, LayerComponent& layer) {
+        layer.world = parent.world + layer.local;
+    };
+
+    ecspp::Tick since = ecspp::AdvanceTick();
+
+    root.Patch<LayerComponent>([](LayerComponent& layer) {
+        layer.local = 5;
+        layer.world = 5;
+    });
+
+    REQUIRE(ecspp::PropagateDown<LayerComponent>(combine, since) == 2);
+    REQUIRE(child.GetComponent<LayerComponent>().world == 6);
+    REQUIRE(grandchild.GetComponent<LayerComponent>().world == 7);
+    REQUIRE(otherChild.GetComponent<LayerComponent>().world == 1);
+
+    since = ecspp::AdvanceTick();
+    REQUIRE(ecspp::PropagateDown<LayerComponent>(combine, since) == 0);
+
+    child.Patch<LayerComponent>([](LayerComponent& layer) {
+        layer.local = 2;
+    });
+
+    REQUIRE(ecspp::PropagateDown<LayerComponent>(combine, since) == 2);
+    REQUIRE(grandchild.GetComponent<LayerComponent>().world == 8);
+
+    ecspp::DeleteAllObjects();
+
+}
+
+struct LinkComponent : public ecspp::DefineComponent<LinkComponent,TestComponent> {
+public:
+    entt::entity target = entt::null;
+
+    void RemapEntities(const ecspp::EntityRemap& remap) {
+        target = remap(target);
+    }
+};
+
+TEST_CASE("Cloning object subtrees") {
+
+    ecspp::DeleteAllObjects();
+
+    TestObject root = TestObject::CreateNew("Root");
+    TestObject first = TestObject::CreateNew("First");
+    TestObject second = TestObject::CreateNew("Second");
+    TestObject grandchild = TestObject::CreateNew("Grandchild");
+    TestObject outside = TestObject::CreateNew("Outside");
+
+    first.SetParent(root);
+    second.SetParent(root);
+    grandchild.SetParent(first);
+
+    root.AddComponent<LinkComponent>();
+    root.GetComponent<LinkComponent>().target = grandchild.ID();
+    second.AddComponent<LinkComponent>();
+    second.GetComponent<LinkComponent>().target = outside.ID();
+    grandchild.AddComponent<VelocityComponent>();
+    grandchild.GetComponent<VelocityComponent>().x = 7;
+
+    TestObject copy = ecspp::CopyObject(root);
+
+    REQUIRE(copy.ID() != root.ID());
+    REQUIRE(!copy.GetParent());
+    REQUIRE(TestObject::GetNumberOfObjects() == 9);
+
+    // the tree keeps its shape instead of becoming a chain
+    REQUIRE(copy.GetChildren().size() == 2);
+    auto descendants = copy.GetDescendants();
+    REQUIRE(descendants.size() == 3);
+    TestObject copiedFirst(descendants[0]);
+    TestObject copiedGrandchild(descendants[1]);
+    TestObject copiedSecond(descendants[2]);
+    REQUIRE(copiedFirst.GetChildren().size() == 1);
+    REQUIRE(copiedGrandchild.GetParent().ID() == copiedFirst.ID());
+
+    REQUIRE(copiedGrandchild.GetComponent<VelocityComponent>().x == 7);
+    REQUIRE(copiedGrandchild.GetComponent<VelocityComponent>().GetMasterHandle() == copiedGrandchild.ID());
+
+    // references inside the subtree follow the clone, the rest stay as they were
+    REQUIRE(copy.GetComponent<LinkComponent>().target == copiedGrandchild.ID());
+    REQUIRE(copiedSecond.GetComponent<LinkComponent>().target == outside.ID());
+    REQUIRE(root.GetComponent<LinkComponent>().target == grandchild.ID());
+    REQUIRE(root.GetChildren().size() == 2);
+
+    ecspp::DeleteAllObjects();
+
+}
+
+TEST_CASE("Cloning large subtrees in parallel") {
+
+    ecspp::DeleteAllObjects();
+
+    // enough components to cross ECSPP_PARALLEL_CLONE_THRESHOLD, spread over two storages
+    const size_t childCount = ECSPP_PARALLEL_CLONE_THRESHOLD / 2 + 1;
+
+    TestObject root = TestObject::CreateNew("Building");
+    std::vector<TestObject> children = TestObject::CreateMany(childCount, "Room");
+    for (size_t i = 0; i < children.size(); i++) {
+        children[i].SetParent(root);
+        children[i].AddComponent<VelocityComponent>().x = static_cast<float>(i);
+        children[i].AddComponent<LinkComponent>().target = children[(i + 1) % childCount].ID();
+    }
+
+    TestObject copy = ecspp::CopyObject(root);
+
+    const auto& copiedChildren = copy.GetChildren();
+    REQUIRE(copiedChildren.size() == childCount);
+    for (size_t i = 0; i < childCount; i++) {
+        TestObject clone = copiedChildren[i].GetAs<TestObject>();
+        REQUIRE(clone.GetComponent<VelocityComponent>().x == static_cast<float>(i));
+        REQUIRE(clone.GetComponent<VelocityComponent>().GetMasterHandle() == clone.ID());
+        REQUIRE(clone.GetComponent<LinkComponent>().GetMasterHandle() == clone.ID());
+        REQUIRE(clone.GetComponent<LinkComponent>().target == copiedChildren[(i + 1) % childCount].ID());
+    }
+
+    ecspp::DeleteAllObjects();
+
+}
+
+TEST_CASE("Running systems in parallel") {
+
+    ecspp::DeleteAllObjects();
+
+    std::vector<TestObject> objects = TestObject::CreateMany(100, "Scheduled");
+
+    for (auto& obj : objects) {
+        obj.AddComponent<CountingComponent>();
+        obj.AddComponent<RandomComponent>();
+    }
+
+    std::atomic<int> independentRuns = 0;
+
+    ecspp::SystemScheduler scheduler(4);
+
+    scheduler.AddSystem("Count", ecspp::Reads<>{}, ecspp::Writes<CountingComponent>{}, [](float delta) {
+        CountingComponent::ForEach([](CountingComponent& comp) {
+            comp.updates++;
+        });
+    });
+
+    scheduler.AddSystem("Copy", ecspp::Reads<CountingComponent>{}, ecspp::Writes<RandomComponent>{}, [](float delta) {
+        for (auto [e, comp] : ecspp::Registry().view<RandomComponent>().each()) {
+            comp.valueOne = ecspp::Registry().get<CountingComponent>(e).updates;
+        }
+    });
+
+    scheduler.AddSystem("Independent", ecspp::Reads<>{}, ecspp::Writes<OtherTestComponent>{}, [&](float delta) {
+        independentRuns++;
+    });
+
+    std::atomic<int> readValues = 0;
+    scheduler.AddSystem("Read", ecspp::Reads<RandomComponent>{}, ecspp::Writes<>{}, [&](float delta) {
+        for (auto& obj : objects) {
+            readValues += obj.ReadComponent<RandomComponent>().valueTwo;
+        }
+    });
+
+    REQUIRE(scheduler.GetNumberOfSystems() == 4);
+
+    ecspp::Tick since = ecspp::AdvanceTick();
+
+    scheduler.Run(0.1f);
+    scheduler.Run(0.1f);
+
+    REQUIRE(independentRuns == 2);
+    REQUIRE(readValues == 2 * 2 * 100);
+
+    // reading doesn't mark anything changed
+    REQUIRE(ecspp::Query<ecspp::With<ecspp::Changed<RandomComponent>>>::Count(since) == 0);
+
+    for (auto& obj : objects) {
+        REQUIRE(obj.GetComponent<RandomComponent>().valueOne == 2);
+    }
+
+    ecspp::DeleteAllObjects();
+
+}
+
 TEST_CASE("Getting templated derived object") {
     FinalDerived obj = FinalDerived::CreateNew("Hi!");
 